@@ -0,0 +1,53 @@
+#pragma once
+
+#include "libs.h"
+
+#include "face.h"
+#include "parallel.h"
+
+/**
+ * compressed sparse row adjacency, built once from faces; entries of vertex i are _indices[_offsets[i]] ... _indices[_offsets[i + 1] - 1]
+ */
+struct Adjacency
+{
+	std::vector<GLuint> _offsets;	/**< start of every vertex' entries (size: vertices + 1)*/
+	std::vector<GLuint> _indices;	/**< entries of all vertices*/
+
+	/**
+	 * first entry of vertex
+	 * @param vertex vertex ID
+	 * @return pointer to the first entry
+	 */
+	inline const GLuint* begin(GLuint vertex) const { return _indices.data() + _offsets[vertex]; }
+	/**
+	 * end of entries of vertex
+	 * @param vertex vertex ID
+	 * @return pointer past the last entry
+	 */
+	inline const GLuint* end(GLuint vertex) const { return _indices.data() + _offsets[vertex + 1]; }
+	/**
+	 * number of entries of vertex
+	 * @param vertex vertex ID
+	 * @return number of entries
+	 */
+	inline size_t size(GLuint vertex) const { return _offsets[vertex + 1] - _offsets[vertex]; }
+
+	/**
+	 * builds vertex -> faces adjacency (positions of faces in the vector)
+	 * @param vertexCount number of vertices (vertex IDs have to be lower)
+	 * @param faces vector of faces
+	 */
+	void buildFaces(size_t vertexCount, const std::vector<Face>& faces);
+	/**
+	 * builds vertex -> neighbors adjacency (sorted, unique vertex IDs)
+	 * @param vertexCount number of vertices (vertex IDs have to be lower)
+	 * @param faces vector of faces
+	 */
+	void buildNeighbors(size_t vertexCount, const std::vector<Face>& faces);
+
+	/**
+	 * memory used by the adjacency
+	 * @return number of bytes
+	 */
+	inline size_t bytes() const { return (_offsets.capacity() + _indices.capacity()) * sizeof(GLuint); }
+};
\ No newline at end of file
@@ -1,199 +1,222 @@
-#pragma once
-
-#include "libs.h"
-
-#include "camera.h"
-#include "shader.h"
-#include "material.h"
-#include "model.h"
-
-//forward class declaration
-class Gui;
-
-/**
- * app class
- */
-class App
-{
-	friend class Gui;
-
-	//	window
-	GLFWwindow* _window;	/**> OpenGL Framework window*/
-	const int _windowWidth;	/**> window width*/
-	const int _windowHeight;	/**> window height*/
-	int _framebufferWidth;	/**> famebuffer width*/
-	int _framebufferHeight;	/**> framebuffer height*/
-
-	//	OpenGL context
-	const int _GLverMajor;	/**> OpenGL major version*/
-	const int _GLverMinor;	/**> OpenGL minor version*/
-
-	//	delta time
-	float _dt = .0f;	/**> delta time*/
-	float _curTime = .0f;	/**> current time*/
-	float _lastTime = .0f;	/**> current time - delta time*/
-
-	//	mouse input
-	double _lastMouseX = .0f;	/**> mouse X position in last time*/
-	double _lastMouseY = .0f;	/**> mouse Y position in last time*/
-	double _mouseX = .0f;	/**> current mouse X position*/
-	double _mouseY = .0f;	/**> current mouse Y position*/
-	double _mouseOffsetX = .0f;	/**> _mouseX - _lastMouseX*/
-	double _mouseOffsetY = .0f;	/**> _mouseY - _lastMouseY*/
-	bool _firstMouse = true;	/**> special check for calculation offset*/
-
-	//	camera
-	Camera _camera;	/**> Camera object*/
-
-	//	matrices
-	glm::mat4 _ViewMatrix;		/**> matrix that can transform everything around the camera*/
-	glm::mat4 _ProjectionMatrix;	/**> projection matrix*/
-
-	//	vectors
-	glm::vec3 _camPosition = glm::vec3(.0f);	/**> camera position*/
-
-	//	render variables
-	float _fov;	/**> field of view*/
-	float _nearPlane;	/**> projection matrix near plane*/
-	float _farPlane;	/**> projection matrix far plane*/
-
-	//	shader
-	Shader* _shader;	/**> Shader object pointer*/
-
-	//	materials
-	std::vector<Material*> _materials;	/**> vector of materials*/
-
-	//	models
-	std::vector<Model*> _models;	/**> vector of models*/
-
-	//	lights
-	std::vector<glm::vec3*> _lights;	/**> vector of simple lights (position only)*/
-
-	//static variable
-	static GLuint _polygonMode;	/**> filled/empty triangles*/
-
-	/**
-	 * initialize OpenGL Framework
-	 */
-	void initGLFW();
-	/**
-	 * initialize GLFW window
-	 * @param title title of the window
-	 * @param resizable if one wants to be able to resize the window. I don't
-	 */
-	void initWindow(const char* title, bool resizable);
-	/**
-	 * initialize OpenGL Extension Wrangler
-	 */
-	void initGLEW();
-	/**
-	 * initialize some OpenGL options
-	 */
-	void initOpenGLOptions();
-	/**
-	 * initialize view and projection matrix
-	 */
-	void initMatrices();
-	/**
-	 * initialize shader
-	 */
-	void initShader();
-	/**
-	 * initialize materials
-	 */
-	void initMaterials();
-	/**
-	 * initialize models
-	 * @param fileName OBJ file name
-	 * @param position model position
-	 * @param rotation model rotation
-	 * @param scale model scale
-	 * @param color vertices color
-	 * @param percentage destinated quantity in % of output vertices compared to input vertices
-	 */
-	void initModels(const char* fileName, glm::vec3 position, glm::vec3 rotation, glm::vec3 scale, glm::vec3 color, GLdouble percentage);
-	/**
-	 * initialize lights position
-	 */
-	void initLights();
-	/**
-	 * initialize uniforms (view matrix, projection matrix, light position)
-	 */
-	void initUniforms();
-
-	/**
-	 * update view and projection matrices uniforms
-	 */
-	void updateUniforms();
-
-public:
-
-	/**
-	 * App constructor
-	 * @param title GLFW window title
-	 * @param width window width
-	 * @param height window height
-	 * @param GLverMajor OpenGL major version
-	 * @param GLverMinor OpenGL minor version
-	 * @param resizable resizable window boolean
-	 */
-	App
-	(
-		const char* title,
-		const int width, const int height,
-		const int GLverMajor, const int GLverMinor,
-		bool resizable
-	);
-
-	/**
-	 * App destructor
-	 */
-	virtual ~App();
-
-	/**
-	 * get "window should close" parameter
-	 */
-	int getWindowShouldClose();
-
-	/**
-	 * set the window to be closed
-	 */
-	void setWindowShouldClose();
-
-	/**
-	 * update delta time
-	 */
-	void updateDt();
-	/**
-	 * update mouse input
-	 */
-	void updateMouseInput();
-	/**
-	 * update keyboard input
-	 */
-	void updateKeyboardInput();
-	/**
-	 * uses updateMouseInput and updateKeyboardInput
-	 */
-	void updateInput();
-	/**
-	 * uses updateDt and updateInput
-	 */
-	void update();
-	/**
-	 * clear color buffer, clear depth buffer
-	 */
-	void clear();
-	/**
-	 * update uniforms and render desired model
-	 */
-	void render(int meshMode);
-
-	/**
-	 * framebuffer resize callback
-	 * @param window GLFW window
-	 * @param fbW framebuffer width
-	 * @param fbH framebuffer height
-	 */
-	static void framebufferResizeCallback(GLFWwindow* window, int fbW, int fbH);
+#pragma once
+
+#include "libs.h"
+
+#include "camera.h"
+#include "shader.h"
+#include "material.h"
+#include "model.h"
+#include "uniformBuffer.h"
+#include "batchRenderer.h"
+
+//forward class declaration
+class Gui;
+
+const int SCENE_MODE = 5;	/**< mesh mode drawing the batched scene*/
+const int SCENE_GRID = 16;	/**< instances per side of the scene grid*/
+const GLfloat SCENE_SPACING = 2.5f;	/**< distance between neighboring instances in bounding sphere radii*/
+
+/**
+ * app class
+ */
+class App
+{
+	friend class Gui;
+
+	//	window
+	GLFWwindow* _window;	/**> OpenGL Framework window*/
+	const int _windowWidth;	/**> window width*/
+	const int _windowHeight;	/**> window height*/
+	int _framebufferWidth;	/**> famebuffer width*/
+	int _framebufferHeight;	/**> framebuffer height*/
+
+	//	OpenGL context
+	const int _GLverMajor;	/**> OpenGL major version*/
+	const int _GLverMinor;	/**> OpenGL minor version*/
+
+	//	delta time
+	float _dt = .0f;	/**> delta time*/
+	float _curTime = .0f;	/**> current time*/
+	float _lastTime = .0f;	/**> current time - delta time*/
+
+	//	mouse input
+	double _lastMouseX = .0f;	/**> mouse X position in last time*/
+	double _lastMouseY = .0f;	/**> mouse Y position in last time*/
+	double _mouseX = .0f;	/**> current mouse X position*/
+	double _mouseY = .0f;	/**> current mouse Y position*/
+	double _mouseOffsetX = .0f;	/**> _mouseX - _lastMouseX*/
+	double _mouseOffsetY = .0f;	/**> _mouseY - _lastMouseY*/
+	bool _firstMouse = true;	/**> special check for calculation offset*/
+
+	//	camera
+	Camera _camera;	/**> Camera object*/
+
+	//	matrices
+	glm::mat4 _ViewMatrix;		/**> matrix that can transform everything around the camera*/
+	glm::mat4 _ProjectionMatrix;	/**> projection matrix*/
+
+	//	vectors
+	glm::vec3 _camPosition = glm::vec3(.0f);	/**> camera position*/
+
+	//	render variables
+	float _fov;	/**> field of view*/
+	float _nearPlane;	/**> projection matrix near plane*/
+	float _farPlane;	/**> projection matrix far plane*/
+
+	//	shader
+	Shader* _shader;	/**> Shader object pointer*/
+	UniformBuffer<FrameUniforms>* _frameUniforms = nullptr;	/**> per-frame uniform block (view, projection, camera and light)*/
+
+	//	materials
+	std::vector<Material*> _materials;	/**> vector of materials*/
+
+	//	models
+	std::vector<Model*> _models;	/**> vector of models*/
+
+	//	scene
+	BatchRenderer* _batch = nullptr;	/**> shared buffers of the scene models*/
+	std::vector<LodLevel> _sceneLevels;	/**> levels of detail in the batch from the finest to the coarsest*/
+	std::vector<size_t> _sceneLod;	/**> level selected for every instance last frame*/
+	GLfloat _lodPixelError = LOD_PIXEL_ERROR;	/**> tolerated screen-space error of selected levels in pixels*/
+	size_t _sceneTriangles = 0;	/**> triangles drawn in the scene last frame*/
+	size_t _sceneVisible = 0;	/**> instances inside the view frustum last frame*/
+
+	//	lights
+	std::vector<glm::vec3*> _lights;	/**> vector of simple lights (position only)*/
+
+	//static variable
+	static GLuint _polygonMode;	/**> filled/empty triangles*/
+
+	/**
+	 * initialize OpenGL Framework
+	 */
+	void initGLFW();
+	/**
+	 * initialize GLFW window
+	 * @param title title of the window
+	 * @param resizable if one wants to be able to resize the window. I don't
+	 */
+	void initWindow(const char* title, bool resizable);
+	/**
+	 * initialize OpenGL Extension Wrangler
+	 */
+	void initGLEW();
+	/**
+	 * initialize some OpenGL options
+	 */
+	void initOpenGLOptions();
+	/**
+	 * initialize view and projection matrix
+	 */
+	void initMatrices();
+	/**
+	 * initialize shader
+	 */
+	void initShader();
+	/**
+	 * initialize materials
+	 */
+	void initMaterials();
+	/**
+	 * initialize models
+	 * @param fileName OBJ file name
+	 * @param position model position
+	 * @param rotation model rotation
+	 * @param scale model scale
+	 * @param color vertices color
+	 * @param target stopping criteria of the simplification
+	 */
+	void initModels(const char* fileName, glm::vec3 position, glm::vec3 rotation, glm::vec3 scale, glm::vec3 color, SimplifyTarget target);
+	/**
+	 * initialize the batched scene from the original and the simplified model
+	 */
+	void initScene();
+	/**
+	 * initialize lights position
+	 */
+	void initLights();
+	/**
+	 * initialize the per-frame uniform block (view matrix, projection matrix, camera and light position)
+	 */
+	void initUniforms();
+
+	/**
+	 * update view and projection matrices and upload the per-frame uniform block
+	 */
+	void updateUniforms();
+	/**
+	 * places a grid of instances, selects their levels of detail by screen-space error and draws them with one batched call
+	 */
+	void renderScene();
+
+public:
+
+	/**
+	 * App constructor
+	 * @param title GLFW window title
+	 * @param width window width
+	 * @param height window height
+	 * @param GLverMajor OpenGL major version
+	 * @param GLverMinor OpenGL minor version
+	 * @param resizable resizable window boolean
+	 */
+	App
+	(
+		const char* title,
+		const int width, const int height,
+		const int GLverMajor, const int GLverMinor,
+		bool resizable
+	);
+
+	/**
+	 * App destructor
+	 */
+	virtual ~App();
+
+	/**
+	 * get "window should close" parameter
+	 */
+	int getWindowShouldClose();
+
+	/**
+	 * set the window to be closed
+	 */
+	void setWindowShouldClose();
+
+	/**
+	 * update delta time
+	 */
+	void updateDt();
+	/**
+	 * update mouse input
+	 */
+	void updateMouseInput();
+	/**
+	 * update keyboard input
+	 */
+	void updateKeyboardInput();
+	/**
+	 * uses updateMouseInput and updateKeyboardInput
+	 */
+	void updateInput();
+	/**
+	 * uses updateDt and updateInput
+	 */
+	void update();
+	/**
+	 * clear color buffer, clear depth buffer
+	 */
+	void clear();
+	/**
+	 * update uniforms and render desired model
+	 */
+	void render(int meshMode);
+
+	/**
+	 * framebuffer resize callback
+	 * @param window GLFW window
+	 * @param fbW framebuffer width
+	 * @param fbH framebuffer height
+	 */
+	static void framebufferResizeCallback(GLFWwindow* window, int fbW, int fbH);
 };
\ No newline at end of file
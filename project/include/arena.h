@@ -0,0 +1,125 @@
+#pragma once
+
+#include "libs.h"
+
+const size_t ARENA_BLOCK_SIZE = 64 * 1024;	/**< default size of arena block in bytes*/
+const size_t POOL_CLASSES = 16;	/**< number of pool size classes (16 B ... 512 KB), bigger requests go to the heap*/
+
+/**
+ * bump allocator; memory is handed out from big blocks and returned all at once by reset, blocks are kept for reuse
+ */
+class Arena
+{
+	std::vector<std::unique_ptr<char[]>> _blocks;	/**< allocated blocks*/
+	std::vector<size_t> _sizes;	/**< sizes of blocks*/
+	size_t _block = 0;	/**< block currently used*/
+	size_t _offset = 0;	/**< first free byte of current block*/
+
+public:
+
+	/**
+	 * default constructor
+	 */
+	inline Arena() {}
+	Arena(const Arena&) = delete;
+	Arena& operator=(const Arena&) = delete;
+
+	/**
+	 * allocates memory valid until the next reset
+	 * @param bytes number of bytes
+	 * @param alignment alignment of returned pointer
+	 * @return pointer to memory
+	 */
+	void* allocate(size_t bytes, size_t alignment);
+	/**
+	 * releases all allocations at once (keeps the blocks)
+	 */
+	inline void reset()
+	{
+		_block = 0;
+		_offset = 0;
+	}
+};
+
+/**
+ * standard allocator over an arena, so std containers can be used as scratch buffers; deallocation does nothing
+ */
+template <typename T>
+struct ArenaAllocator
+{
+	typedef T value_type;
+
+	Arena* _arena;	/**< pointer to arena*/
+
+	/**
+	 * constructor
+	 * @param arena reference to arena
+	 */
+	inline ArenaAllocator(Arena& arena) : _arena(&arena) {}
+	/**
+	 * rebind constructor
+	 * @param a allocator of another type
+	 */
+	template <typename U>
+	inline ArenaAllocator(const ArenaAllocator<U>& a) : _arena(a._arena) {}
+
+	/**
+	 * allocates memory for n objects
+	 * @param n number of objects
+	 * @return pointer to memory
+	 */
+	inline T* allocate(size_t n) { return static_cast<T*>(_arena->allocate(n * sizeof(T), alignof(T))); }
+	/**
+	 * memory is released by Arena::reset
+	 */
+	inline void deallocate(T*, size_t) {}
+
+	template <typename U>
+	inline bool operator==(const ArenaAllocator<U>& a) const { return _arena == a._arena; }
+	template <typename U>
+	inline bool operator!=(const ArenaAllocator<U>& a) const { return _arena != a._arena; }
+};
+
+/**
+ * vector allocated from an arena
+ */
+template <typename T>
+using ArenaVector = std::vector<T, ArenaAllocator<T>>;
+
+/**
+ * pool of power-of-two sized chunks with free lists; freed chunks are reused by the next request of the same class, so memory does not fragment
+ */
+class Pool
+{
+	Arena _arena;	/**< memory of chunks (never reset)*/
+	std::array<void*, POOL_CLASSES> _free = {};	/**< free lists of size classes*/
+	std::mutex _mutex;	/**< chunks may be allocated and freed by different threads*/
+
+	/**
+	 * size class of a request
+	 * @param bytes number of bytes
+	 * @return index of size class (POOL_CLASSES - too big for the pool)
+	 */
+	static size_t sizeClass(size_t bytes);
+
+public:
+
+	/**
+	 * allocates a chunk
+	 * @param bytes number of bytes
+	 * @return pointer to memory
+	 */
+	void* allocate(size_t bytes);
+	/**
+	 * returns a chunk to its free list
+	 * @param p pointer returned by allocate
+	 * @param bytes number of bytes passed to allocate
+	 */
+	void deallocate(void* p, size_t bytes);
+};
+
+/**
+ * pool of topology storage (vertex rings that do not fit inline), shared by all meshes
+ * @return reference to pool
+ */
+Pool& topologyPool();
\ No newline at end of file
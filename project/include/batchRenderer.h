@@ -0,0 +1,126 @@
+#pragma once
+
+#include "libs.h"
+
+#include "mesh.h"
+#include "streamBuffer.h"
+
+const GLuint BATCH_INSTANCES_BINDING = 0;	/**< shader storage binding point of the Instances block*/
+const GLuint BATCH_INSTANCE_LOCATION = 4;	/**< vertex attribute location of the instance index*/
+
+/**
+ * geometry of one mesh within the shared buffers of a batch
+ */
+struct BatchMesh
+{
+	GLuint _firstIndex = 0;	/**< first index in the shared index buffer*/
+	GLuint _count = 0;	/**< number of indices*/
+	GLint _baseVertex = 0;	/**< first vertex in the shared vertex buffer*/
+	VertexDequantization _dequantization;	/**< decoding of the mesh's quantized positions*/
+	glm::vec3 _center = glm::vec3(.0f);	/**< bounding sphere center in object space*/
+	GLfloat _radius = .0f;	/**< bounding sphere radius in object space*/
+};
+
+/**
+ * per-instance data read by the vertex shader (Instances block, std430)
+ */
+struct BatchInstance
+{
+	glm::mat4 _model;	/**< model matrix*/
+	glm::vec4 _positionOffset;	/**< dequantization offset of the instance's mesh (xyz)*/
+	glm::vec4 _positionScale;	/**< dequantization scale of the instance's mesh (xyz)*/
+};
+
+/**
+ * command of glMultiDrawElementsIndirect
+ */
+struct DrawElementsIndirectCommand
+{
+	GLuint _count;	/**< number of indices*/
+	GLuint _instanceCount;	/**< number of instances*/
+	GLuint _firstIndex;	/**< first index*/
+	GLint _baseVertex;	/**< value added to indices*/
+	GLuint _baseInstance;	/**< first instance, offsets the instance index attribute*/
+};
+
+/**
+ * renderer drawing many instances of many meshes with a single call; meshes share one vertex and one index buffer, instances are grouped by mesh into indirect commands and their model matrices are read from a shader storage buffer
+ */
+class BatchRenderer
+{
+	std::vector<BatchMesh> _meshes;	/**< meshes in the shared buffers*/
+	std::vector<uint8_t> _vertexData;	/**< shared vertices, kept until build*/
+	std::vector<GLuint> _indexData;	/**< shared indices, kept until build*/
+	PackedVertices _format;	/**< vertex format of all meshes (attributes of the first one)*/
+
+	std::vector<std::pair<GLuint, glm::mat4>> _instances;	/**< mesh and model matrix of every instance*/
+	std::vector<BatchInstance> _instanceData;	/**< instances sorted by mesh*/
+	std::vector<DrawElementsIndirectCommand> _commands;	/**< one command per mesh with instances*/
+
+	GLuint _VAO = 0;	/**< vertex array object ID*/
+	GLuint _VBO = 0;	/**< shared vertex buffer ID*/
+	GLuint _EBO = 0;	/**< shared index buffer ID*/
+	GLuint _instanceIndices = 0;	/**< buffer of 0, 1, 2, ... read per instance (with base instance it gives the index into Instances)*/
+	GLuint _instanceCapacity = 0;	/**< number of values in _instanceIndices*/
+	StreamBuffer _instanceStream;	/**< per-frame instance data*/
+	StreamBuffer _commandStream;	/**< per-frame indirect commands*/
+
+public:
+
+	/**
+	 * batch renderer constructor
+	 */
+	BatchRenderer() = default;
+	BatchRenderer(const BatchRenderer&) = delete;
+	BatchRenderer& operator=(const BatchRenderer&) = delete;
+	/**
+	 * batch renderer destructor
+	 */
+	~BatchRenderer();
+
+	/**
+	 * appends geometry of a shaded mesh, all meshes of a batch have to share the vertex format
+	 * @param mesh pointer to mesh
+	 * @return index of the mesh in the batch
+	 */
+	GLuint addMesh(const Mesh* mesh);
+	/**
+	 * uploads the shared buffers, meshes can not be added afterwards
+	 */
+	void build();
+
+	/**
+	 * removes all instances
+	 */
+	inline void clearInstances() { _instances.clear(); }
+	/**
+	 * adds an instance drawn by the next render
+	 * @param mesh index of the mesh in the batch
+	 * @param model model matrix
+	 */
+	inline void addInstance(GLuint mesh, const glm::mat4& model) { _instances.push_back({ mesh, model }); }
+
+	/**
+	 * draws all instances with one glMultiDrawElementsIndirect
+	 * @param shader pointer to shader
+	 * @param polygonMode filled/empty triangles
+	 */
+	void render(Shader* shader, GLuint polygonMode);
+
+	/**
+	 * mesh getter
+	 * @param mesh index of the mesh in the batch
+	 * @return mesh geometry
+	 */
+	inline const BatchMesh& getMesh(GLuint mesh) const { return _meshes[mesh]; }
+	/**
+	 * number of instances
+	 * @return number of instances
+	 */
+	inline size_t instances() const { return _instances.size(); }
+	/**
+	 * number of indirect commands issued by the last render
+	 * @return number of commands
+	 */
+	inline size_t commands() const { return _commands.size(); }
+};
\ No newline at end of file
@@ -0,0 +1,139 @@
+#pragma once
+
+#include "libs.h"
+
+#include "parallel.h"
+
+const size_t BVH_BINS = 16;	/**< SAH bins per axis*/
+const size_t BVH_LEAF_SIZE = 4;	/**< nodes with this many triangles or less are always leaves*/
+const size_t BVH_MAX_LEAF_SIZE = 16;	/**< nodes with more triangles are split even if SAH prefers a leaf*/
+const size_t BVH_MAX_DEPTH = 63;	/**< nodes at this depth are leaves regardless of their size (bounds the traversal stack)*/
+const size_t BVH_PARALLEL_SIZE = 4096;	/**< smallest node whose children are built on separate threads*/
+
+/**
+ * closest point of triangle to a point (Ericson, Real-Time Collision Detection 5.1.5)
+ * @param p point
+ * @param a first corner
+ * @param b second corner
+ * @param c third corner
+ * @return closest point
+ */
+inline glm::vec3 closestPointOnTriangle(const glm::vec3& p, const glm::vec3& a, const glm::vec3& b, const glm::vec3& c)
+{
+	glm::vec3 ab = b - a;
+	glm::vec3 ac = c - a;
+	glm::vec3 ap = p - a;
+	GLfloat d1 = glm::dot(ab, ap);
+	GLfloat d2 = glm::dot(ac, ap);
+	if (d1 <= .0f && d2 <= .0f)
+		return a;
+
+	glm::vec3 bp = p - b;
+	GLfloat d3 = glm::dot(ab, bp);
+	GLfloat d4 = glm::dot(ac, bp);
+	if (d3 >= .0f && d4 <= d3)
+		return b;
+
+	GLfloat vc = d1 * d4 - d3 * d2;
+	if (vc <= .0f && d1 >= .0f && d3 <= .0f)
+		return a + ab * (d1 / (d1 - d3));
+
+	glm::vec3 cp = p - c;
+	GLfloat d5 = glm::dot(ab, cp);
+	GLfloat d6 = glm::dot(ac, cp);
+	if (d6 >= .0f && d5 <= d6)
+		return c;
+
+	GLfloat vb = d5 * d2 - d1 * d6;
+	if (vb <= .0f && d2 >= .0f && d6 <= .0f)
+		return a + ac * (d2 / (d2 - d6));
+
+	GLfloat va = d3 * d6 - d5 * d4;
+	if (va <= .0f && d4 - d3 >= .0f && d5 - d6 >= .0f)
+		return b + (c - b) * ((d4 - d3) / ((d4 - d3) + (d5 - d6)));
+
+	//inside the face
+	GLfloat denominator = 1.f / (va + vb + vc);
+	return a + ab * (vb * denominator) + ac * (vc * denominator);
+}
+
+/**
+ * node of bounding volume hierarchy, 32 bytes
+ */
+struct BvhNode
+{
+	glm::vec3 _min;	/**< lower corner of bounding box*/
+	GLuint _first;	/**< first triangle of leaf, or left child of inner node (right child follows it)*/
+	glm::vec3 _max;	/**< upper corner of bounding box*/
+	GLuint _count;	/**< number of triangles of leaf (0 - inner node)*/
+};
+
+/**
+ * bounding volume hierarchy over a triangle soup for closest point queries; built top-down with binned SAH, subtrees in parallel
+ */
+class Bvh
+{
+	std::vector<BvhNode> _nodes;	/**< nodes, root first*/
+	std::vector<std::array<glm::vec3, 3>> _triangles;	/**< corners of triangles in leaf order*/
+	std::vector<GLuint> _ids;	/**< input position of every triangle in leaf order*/
+
+	/**
+	 * builds node and its subtree over a range of triangle indices
+	 * @param node index of node to fill
+	 * @param begin first index in the order vector
+	 * @param end one past the last index
+	 * @param depth depth of the node
+	 * @param order triangle indices, partitioned in place
+	 * @param bounds bounding boxes of triangles (min, max)
+	 * @param centroids centroids of bounding boxes of triangles
+	 * @param nodeCount number of used nodes
+	 */
+	void buildNode
+	(
+		GLuint node,
+		size_t begin,
+		size_t end,
+		size_t depth,
+		std::vector<GLuint>& order,
+		const std::vector<std::array<glm::vec3, 2>>& bounds,
+		const std::vector<glm::vec3>& centroids,
+		std::atomic<GLuint>& nodeCount
+	);
+
+public:
+	/**
+	 * builds the hierarchy
+	 * @param positions vertex positions
+	 * @param triangles indices of triangles' corners into positions
+	 */
+	void build(const std::vector<glm::vec3>& positions, const std::vector<std::array<GLuint, 3>>& triangles);
+
+	/**
+	 * checks if there are no triangles
+	 * @return boolean value
+	 */
+	inline bool empty() const { return _triangles.empty(); }
+	/**
+	 * number of triangles
+	 * @return number of triangles
+	 */
+	inline size_t size() const { return _triangles.size(); }
+
+	/**
+	 * closest point of all triangles to a point
+	 * @param p point
+	 * @param closest closest point (unchanged if nothing is closer than maxDistance2)
+	 * @param maxDistance2 squared distance above which triangles are skipped
+	 * @param triangle input position of triangle containing the closest point (nullptr - not needed)
+	 * @return squared distance (maxDistance2 if nothing is closer)
+	 */
+	GLfloat closestPoint(const glm::vec3& p, glm::vec3& closest, GLfloat maxDistance2 = std::numeric_limits<GLfloat>::max(), GLuint* triangle = nullptr) const;
+	/**
+	 * moves a batch of points to their closest points, queries run on all hardware threads
+	 * @param count number of points
+	 * @param x x coordinates, overwritten
+	 * @param y y coordinates, overwritten
+	 * @param z z coordinates, overwritten
+	 */
+	void project(size_t count, GLfloat* x, GLfloat* y, GLfloat* z) const;
+};
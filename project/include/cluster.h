@@ -0,0 +1,85 @@
+#pragma once
+
+#include "libs.h"
+
+const GLuint CLUSTER_VERTICES = 64;	/**< most vertices referenced by one cluster*/
+const GLuint CLUSTER_TRIANGLES = 124;	/**< most triangles of one cluster*/
+const GLfloat CLUSTER_CONE_LIMIT = .1f;	/**< lowest cosine between the cone axis and a triangle normal, wider clusters are never back-facing*/
+
+/**
+ * bounding sphere
+ */
+struct BoundingSphere
+{
+	glm::vec3 _center = glm::vec3(.0f);	/**< center*/
+	GLfloat _radius = .0f;	/**< radius*/
+};
+
+/**
+ * run of consecutive triangles of an index buffer with its bounds (meshlet)
+ */
+struct Cluster
+{
+	GLuint _firstIndex = 0;	/**< first index in the index buffer*/
+	GLuint _count = 0;	/**< number of indices*/
+	BoundingSphere _bounds;	/**< bounding sphere of the triangles*/
+	glm::vec3 _coneAxis = glm::vec3(.0f);	/**< average direction of triangle normals*/
+	GLfloat _coneCutoff = 1.f;	/**< sine of the widest angle between the axis and a normal (1 - the cluster is never back-facing)*/
+
+	/**
+	 * checks if all triangles face away from the eye, conservatively for any point of the bounding sphere
+	 * @param eye camera position in the space of the cluster
+	 * @return true if the cluster can be skipped
+	 */
+	inline bool backFacing(const glm::vec3& eye) const
+	{
+		glm::vec3 view = _bounds._center - eye;
+		return glm::dot(view, _coneAxis) >= _coneCutoff * glm::length(view) + _bounds._radius;
+	}
+};
+
+/**
+ * view frustum as 6 planes pointing inside (Gribb, Hartmann)
+ */
+struct Frustum
+{
+	std::array<glm::vec4, 6> _planes;	/**< normalized planes (left, right, bottom, top, near, far)*/
+
+	/**
+	 * extracts planes of the clip space volume
+	 * @param matrix matrix to clip space (projection * view * model gives planes in object space)
+	 */
+	Frustum(const glm::mat4& matrix);
+
+	/**
+	 * checks if sphere is at least partially inside
+	 * @param sphere bounding sphere in the space of the planes
+	 * @return false if the sphere is outside of a plane
+	 */
+	inline bool intersects(const BoundingSphere& sphere) const
+	{
+		for (auto& p : _planes)
+			if (glm::dot(glm::vec3(p), sphere._center) + p.w < -sphere._radius)
+				return false;
+		return true;
+	}
+};
+
+/**
+ * bounding sphere of points, centered in their bounding box
+ * @param positions vertex positions
+ * @param indices indices of points
+ * @param first first index
+ * @param count number of indices
+ * @return bounding sphere
+ */
+BoundingSphere boundingSphere(const std::vector<glm::vec3>& positions, const std::vector<GLuint>& indices, size_t first, size_t count);
+
+/**
+ * splits a triangle list into runs of consecutive triangles with at most CLUSTER_VERTICES vertices and CLUSTER_TRIANGLES triangles; triangles should already be ordered for locality (vertex cache order)
+ * @param positions vertex positions
+ * @param normals vertex normals orienting the triangles, whose vertices need not be wound (empty - clusters get no cone)
+ * @param indices triangle list
+ * @return clusters in index order
+ */
+std::vector<Cluster> buildClusters(const std::vector<glm::vec3>& positions, const std::vector<glm::vec3>& normals, const std::vector<GLuint>& indices);
\ No newline at end of file
@@ -0,0 +1,85 @@
+#pragma once
+
+#include "libs.h"
+
+#include "bvh.h"
+#include "parallel.h"
+
+const size_t DEVIATION_SAMPLES = 32768;	/**< area-weighted samples per direction (every vertex is sampled too)*/
+const size_t DEVIATION_BLOCK = 1024;	/**< samples reduced together; blocks are summed in order, so results do not depend on the number of threads*/
+const uint32_t DEVIATION_SEED = 1;	/**< default seed of sample positions*/
+
+/**
+ * distances from samples on one surface to another surface
+ */
+struct Deviation
+{
+	GLdouble _max = 0.0;	/**< largest distance (one-sided Hausdorff distance)*/
+	GLdouble _mean = 0.0;	/**< mean distance*/
+	GLdouble _rms = 0.0;	/**< root mean square distance*/
+	size_t _samples = 0;	/**< number of samples*/
+};
+
+/**
+ * deviation between two surfaces measured in both directions (metro)
+ */
+struct SurfaceDeviation
+{
+	Deviation _forward;	/**< samples on the first surface, distances to the second one*/
+	Deviation _backward;	/**< samples on the second surface, distances to the first one*/
+
+	/**
+	 * symmetric Hausdorff distance
+	 * @return distance
+	 */
+	inline GLdouble hausdorff() const { return std::max(_forward._max, _backward._max); }
+	/**
+	 * mean distance of all samples of both directions
+	 * @return distance
+	 */
+	inline GLdouble mean() const
+	{
+		size_t samples = std::max<size_t>(1, _forward._samples + _backward._samples);
+		return (_forward._mean * _forward._samples + _backward._mean * _backward._samples) / samples;
+	}
+	/**
+	 * root mean square distance of all samples of both directions
+	 * @return distance
+	 */
+	inline GLdouble rms() const
+	{
+		size_t samples = std::max<size_t>(1, _forward._samples + _backward._samples);
+		return std::sqrt((_forward._rms * _forward._rms * _forward._samples + _backward._rms * _backward._rms * _backward._samples) / samples);
+	}
+};
+
+/**
+ * measures distances from samples on a surface to another surface; every vertex is a sample, the rest are spread over triangles by area, their positions depend only on the seed
+ * @param positions vertex positions of sampled surface
+ * @param triangles indices of triangles' corners of sampled surface
+ * @param target hierarchy of the other surface
+ * @param samples number of area-weighted samples
+ * @param seed seed of sample positions
+ * @return deviation
+ */
+Deviation sampleDeviation(const std::vector<glm::vec3>& positions, const std::vector<std::array<GLuint, 3>>& triangles, const Bvh& target, size_t samples = DEVIATION_SAMPLES, uint32_t seed = DEVIATION_SEED);
+
+/**
+ * measures deviation between two surfaces in both directions; both hierarchies are built and queried in parallel
+ * @param positionsA vertex positions of first surface
+ * @param trianglesA indices of triangles' corners of first surface
+ * @param positionsB vertex positions of second surface
+ * @param trianglesB indices of triangles' corners of second surface
+ * @param samples number of area-weighted samples per direction
+ * @param seed seed of sample positions
+ * @return deviation
+ */
+SurfaceDeviation surfaceDeviation
+(
+	const std::vector<glm::vec3>& positionsA,
+	const std::vector<std::array<GLuint, 3>>& trianglesA,
+	const std::vector<glm::vec3>& positionsB,
+	const std::vector<std::array<GLuint, 3>>& trianglesB,
+	size_t samples = DEVIATION_SAMPLES,
+	uint32_t seed = DEVIATION_SEED
+);
\ No newline at end of file
@@ -0,0 +1,57 @@
+#pragma once
+
+#include "libs.h"
+
+/**
+ * enum containing instruction sets of the edge cost kernel
+ */
+enum simdLevel
+{
+	SIMD_SCALAR = 0,	/**< one edge at a time*/
+	SIMD_SSE,	/**< 4 edges at a time (SSE2, available on every x64 CPU)*/
+	SIMD_AVX2	/**< 8 edges at a time with gathered loads*/
+};
+
+/**
+ * structure-of-arrays input of the edge cost kernel; edge i joins slots _a[i] and _b[i]
+ */
+struct EdgeCostInput
+{
+	const GLfloat* _x;	/**< x coordinates of slots*/
+	const GLfloat* _y;	/**< y coordinates of slots*/
+	const GLfloat* _z;	/**< z coordinates of slots*/
+	std::array<const GLfloat*, 10> _quad;	/**< upper triangle coefficients of slots' quadrics (a00 a01 a02 a03 a11 a12 a13 a22 a23 a33)*/
+	const GLuint* _a;	/**< first slot of edges*/
+	const GLuint* _b;	/**< second slot of edges*/
+};
+
+/**
+ * best instruction set supported by the CPU and the OS (detected once)
+ * @return SIMD level
+ */
+simdLevel simdSupported();
+/**
+ * name of instruction set
+ * @param level SIMD level
+ * @return name
+ */
+const char* simdName(simdLevel level);
+
+/**
+ * computes cost of collapsing one edge to its midpoint, same arithmetic as the kernels (one-pass loops over vertex structures use it directly)
+ * @param a position of first vertex
+ * @param b position of second vertex
+ * @param qa quadric of first vertex
+ * @param qb quadric of second vertex
+ * @return max(v^T * (Qa + Qb) * v, 0)
+ */
+GLfloat edgeCost(const glm::vec3& a, const glm::vec3& b, const glm::mat4& qa, const glm::mat4& qb);
+
+/**
+ * computes cost of collapsing edges to their midpoints, max(v^T * (Qa + Qb) * v, 0)
+ * @param input pointers to slot and edge arrays
+ * @param count number of edges
+ * @param costs output array, one cost per edge
+ * @param level instruction set to use (must be supported)
+ */
+void edgeCostKernel(const EdgeCostInput& input, size_t count, GLfloat* costs, simdLevel level = simdSupported());
\ No newline at end of file
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "libs.h"
+
+#include "face.h"
+#include "parallel.h"
+
+const GLuint NO_FACE = std::numeric_limits<GLuint>::max();	/**< missing face of a boundary edge*/
+
+/**
+ * unique edges of faces with the faces on both sides, built once from faces by radix sorting 64-bit (min, max) vertex keys
+ */
+struct EdgeTable
+{
+	std::vector<uint64_t> _keys;	/**< (min << 32 | max) vertex IDs of every edge, sorted*/
+	std::vector<std::array<GLuint, 2>> _faces;	/**< positions of the first two faces of every edge (NO_FACE - boundary)*/
+	std::vector<GLuint> _faceCounts;	/**< number of faces of every edge (1 - boundary, 2 - manifold, more - non-manifold)*/
+
+	/**
+	 * packs an edge into a key
+	 * @param a ID of first vertex
+	 * @param b ID of second vertex
+	 * @return key
+	 */
+	static inline uint64_t key(GLuint a, GLuint b)
+	{
+		return (static_cast<uint64_t>(std::min(a, b)) << 32) | std::max(a, b);
+	}
+	/**
+	 * smaller vertex of edge
+	 * @param i edge index
+	 * @return vertex ID
+	 */
+	inline GLuint first(size_t i) const { return static_cast<GLuint>(_keys[i] >> 32); }
+	/**
+	 * bigger vertex of edge
+	 * @param i edge index
+	 * @return vertex ID
+	 */
+	inline GLuint second(size_t i) const { return static_cast<GLuint>(_keys[i] & 0xffffffff); }
+	/**
+	 * number of edges
+	 * @return number of edges
+	 */
+	inline size_t size() const { return _keys.size(); }
+
+	/**
+	 * builds the table in linear time
+	 * @param faces vector of faces
+	 */
+	void build(const std::vector<Face>& faces);
+};
\ No newline at end of file
@@ -1,30 +1,47 @@
-#pragma once
-
-#include "libs.h"
-
-/**
- * mesh face class
- */
-struct Face
-{
-	GLuint _id;
-	std::array<GLuint, 3> _vertices = { {0, 0, 0} };
-
-	/**
-	 * face constructor
-	 * @param id new face ID
-	 * @param vertices array of vertices for the new face
-	 */
-	inline Face(GLuint id, std::array<GLuint, 3> vertices) : _id(id), _vertices(vertices)
-	{
-		std::sort(_vertices.begin(), _vertices.end());
-	}
-
-	/**
-	 * vertex array sort method
-	 */
-	inline void sortVertices()
-	{
-		std::sort(_vertices.begin(), _vertices.end());
-	}
+#pragma once
+
+#include "libs.h"
+
+/**
+ * mesh face class
+ */
+struct Face
+{
+	GLuint _id;
+	std::array<GLuint, 3> _vertices = { {0, 0, 0} };
+	std::array<GLuint, 3> _wedges = { {0, 0, 0} };	/**< attribute vertices (wedges) of corners, sorted together with _vertices*/
+
+	/**
+	 * face constructor
+	 * @param id new face ID
+	 * @param vertices array of vertices for the new face
+	 */
+	inline Face(GLuint id, std::array<GLuint, 3> vertices) : _id(id), _vertices(vertices)
+	{
+		std::sort(_vertices.begin(), _vertices.end());
+	}
+	/**
+	 * face constructor with attribute vertices
+	 * @param id new face ID
+	 * @param vertices array of vertices for the new face
+	 * @param wedges array of attribute vertices of the corners
+	 */
+	inline Face(GLuint id, std::array<GLuint, 3> vertices, std::array<GLuint, 3> wedges) : _id(id), _vertices(vertices), _wedges(wedges)
+	{
+		sortVertices();
+	}
+
+	/**
+	 * vertex array sort method (keeps wedges of corners aligned)
+	 */
+	inline void sortVertices()
+	{
+		for (size_t i = 0; i < 2; ++i)
+			for (size_t j = 0; j < 2 - i; ++j)
+				if (_vertices[j] > _vertices[j + 1])
+				{
+					std::swap(_vertices[j], _vertices[j + 1]);
+					std::swap(_wedges[j], _wedges[j + 1]);
+				}
+	}
 };
\ No newline at end of file
@@ -1,77 +1,90 @@
-#include "libs.h"
-
-#include "app.h"
-
-/**
- * GUI class
- */
-class Gui
-{
-	App* _app;	/**> App object pointer*/
-
-	bool _filledPolygons = false;	/**> filled polygons check*/
-	char _filePath[100] = "obj files/capybara.obj";	/**> file path char array*/
-	GLfloat _percentage = 20.f;	/**> percentage destinated quantity in % of output vertices compared to input vertices*/
-
-	bool _toInit = false;	/**> check if models are ready to initialize*/
-	int _meshMode = 1;	/**> mesh mode for radio buttons*/
-	std::string _log;	/**> mesh loading log*/
-
-public:
-
-	/**
-	 * contructor
-	 * @param title GLFW window title
-	 * @param width window width
-	 * @param height window height
-	 * @param GLverMajor OpenGL major version
-	 * @param GLverMinor OpenGL minor version
-	 * @param resizable resizable window boolean
-	 */
-	Gui
-	(
-		const char* title,
-		const int width, const int height,
-		const int GLverMajor, const int GLverMinor,
-		bool resizable
-	);
-
-	/**
-	 * destructor
-	 */
-	~Gui()
-	{
-		delete _app;
-	}
-
-	/**
-	 * App getter
-	 * @return App object pointer
-	 */
-	App* getApp()
-	{
-		return _app;
-	}
-
-	/**
-	 * new ImGui frame
-	 */
-	void newFrame();
-	/**
-	 * clear GUI
-	 */
-	void clear();
-	/**
-	 * render GUI
-	 */
-	void render();
-	/**
-	 * shutdown GUI
-	 */
-	void shutdown();
-
-	/**
-	 * render loop
-	 */
-	void loop();
+#include "libs.h"
+
+#include "app.h"
+
+/**
+ * GUI class
+ */
+class Gui
+{
+	App* _app;	/**> App object pointer*/
+
+	bool _filledPolygons = false;	/**> filled polygons check*/
+	char _filePath[100] = "obj files/capybara.obj";	/**> file path char array*/
+	GLfloat _percentage = 20.f;	/**> percentage destinated quantity in % of output vertices compared to input vertices*/
+	int _targetMode = 0;	/**> simplification stopping criterion for radio buttons*/
+	bool _clustering = false;	/**> fast vertex clustering instead of QEM*/
+	bool _livePreview = false;	/**> draw intermediate states of the simplification and remeshing (included in their processing times)*/
+	GLfloat _maxError = .0001f;	/**> highest quadric error of a single collapse*/
+	int _targetFaces = 1000;	/**> triangle budget*/
+	GLfloat _pixelError = 1.f;	/**> tolerated screen-space error in pixels*/
+	GLfloat _viewDistance = 10.f;	/**> distance from the camera used for screen-space error*/
+
+	bool _toInit = false;	/**> check if models are ready to initialize*/
+	int _meshMode = 1;	/**> mesh mode for radio buttons*/
+	std::string _log;	/**> mesh loading log*/
+
+public:
+
+	/**
+	 * contructor
+	 * @param title GLFW window title
+	 * @param width window width
+	 * @param height window height
+	 * @param GLverMajor OpenGL major version
+	 * @param GLverMinor OpenGL minor version
+	 * @param resizable resizable window boolean
+	 */
+	Gui
+	(
+		const char* title,
+		const int width, const int height,
+		const int GLverMajor, const int GLverMinor,
+		bool resizable
+	);
+
+	/**
+	 * destructor
+	 */
+	~Gui()
+	{
+		delete _app;
+	}
+
+	/**
+	 * App getter
+	 * @return App object pointer
+	 */
+	App* getApp()
+	{
+		return _app;
+	}
+
+	/**
+	 * builds simplification stopping criteria from GUI values
+	 * @return simplify target
+	 */
+	SimplifyTarget getSimplifyTarget();
+
+	/**
+	 * new ImGui frame
+	 */
+	void newFrame();
+	/**
+	 * clear GUI
+	 */
+	void clear();
+	/**
+	 * render GUI
+	 */
+	void render();
+	/**
+	 * shutdown GUI
+	 */
+	void shutdown();
+
+	/**
+	 * render loop
+	 */
+	void loop();
 };
\ No newline at end of file
@@ -0,0 +1,61 @@
+#pragma once
+
+#include "libs.h"
+
+const size_t SHORT_INDEX_VERTICES = 65536;	/**< highest vertex count addressed by 16-bit indices*/
+const uint32_t INDEX_FILE_MAGIC = 0x31584449;	/**< "IDX1", header of compressed index files*/
+
+/**
+ * render-export of indices; 16-bit indices are used when all vertices can be addressed by them
+ */
+struct PackedIndices
+{
+	std::vector<uint8_t> _data;	/**< index data*/
+	GLenum _type = GL_UNSIGNED_INT;	/**< GL_UNSIGNED_SHORT or GL_UNSIGNED_INT*/
+	GLsizei _count = 0;	/**< number of indices*/
+
+	/**
+	 * size of data in bytes
+	 * @return bytes
+	 */
+	inline size_t bytes() const { return _data.size(); }
+
+	/**
+	 * packs indices into the narrowest type addressing all vertices
+	 * @param indices indices
+	 * @param vertexCount number of vertices (indices have to be lower)
+	 * @return packed indices
+	 */
+	static PackedIndices pack(const std::vector<GLuint>& indices, size_t vertexCount);
+};
+
+/**
+ * compresses indices; every index is stored as the zigzag difference from the next not yet used vertex in a LEB128 varint, so indices in vertex fetch order (new vertex or recently used one) mostly take one byte
+ * @param indices indices
+ * @return encoded bytes (number of indices first)
+ */
+std::vector<uint8_t> encodeIndices(const std::vector<GLuint>& indices);
+
+/**
+ * decompresses indices encoded by encodeIndices
+ * @param data encoded bytes
+ * @param indices decoded indices
+ * @return false if data are truncated or malformed
+ */
+bool decodeIndices(const std::vector<uint8_t>& data, std::vector<GLuint>& indices);
+
+/**
+ * writes compressed indices into file
+ * @param fileName file name
+ * @param indices indices
+ * @return false if file can not be written
+ */
+bool saveIndices(const char* fileName, const std::vector<GLuint>& indices);
+
+/**
+ * reads compressed indices from file
+ * @param fileName file name
+ * @param indices decoded indices
+ * @return false if file can not be read or is not an index file
+ */
+bool loadIndices(const char* fileName, std::vector<GLuint>& indices);
\ No newline at end of file
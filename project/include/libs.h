@@ -1,32 +1,54 @@
-//std
-#include <iostream>
-#include <fstream>
-#include <sstream>
-#include <string>
-#include <cstring>
-#include <cstdlib>
-#include <cmath>
-#include <vector>
-#include <algorithm>
-#include <array>
-#include <set>
-#include <chrono>
-
-//OpenGL Extension Wrangler
-#include <glew.h>
-
-//Graphics Library Framework
-#include <glfw3.h>
-
-//OpenGL Mathematics
-#include <glm.hpp>
-#include <vec3.hpp>
-#include <vec4.hpp>
-#include <mat4x4.hpp>
-#include <gtc\matrix_transform.hpp>
-#include <gtc\type_ptr.hpp>
-
-//ImGui
-#include <imgui.h>
-#include <imgui_impl_glfw.h>
+//std
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <cstring>
+#include <cstdlib>
+#include <cmath>
+#include <vector>
+#include <algorithm>
+#include <array>
+#include <set>
+#include <map>
+#include <unordered_map>
+#include <queue>
+#include <functional>
+#include <chrono>
+#include <thread>
+#include <cstdint>
+#include <cfloat>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <cstddef>
+#include <atomic>
+#include <iterator>
+
+//SIMD intrinsics, CPU feature detection (x86 only, other targets use scalar code)
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define SIMD_X86
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+//OpenGL Extension Wrangler
+#include <glew.h>
+
+//Graphics Library Framework
+#include <glfw3.h>
+
+//OpenGL Mathematics
+#include <glm.hpp>
+#include <vec3.hpp>
+#include <vec4.hpp>
+#include <mat4x4.hpp>
+#include <gtc\matrix_transform.hpp>
+#include <gtc\type_ptr.hpp>
+
+//ImGui
+#include <imgui.h>
+#include <imgui_impl_glfw.h>
 #include <imgui_impl_opengl3.h>
\ No newline at end of file
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "libs.h"
+
+const GLfloat LOD_PIXEL_ERROR = 1.f;	/**< default tolerated screen-space error of the selected level in pixels*/
+const GLfloat LOD_HYSTERESIS = .25f;	/**< relative band under the tolerated error in which the selected level is kept, so levels do not pop back and forth*/
+
+/**
+ * level of detail of a model
+ */
+struct LodLevel
+{
+	GLuint _mesh = 0;	/**< mesh drawn for this level*/
+	GLfloat _error = .0f;	/**< geometric error against the finest level in object space (Hausdorff distance measured after simplification)*/
+	GLsizei _triangles = 0;	/**< number of triangles*/
+};
+
+/**
+ * pixels covered by one unit of length at a distance from the camera
+ * @param distance distance from the camera
+ * @param fov vertical field of view in degrees
+ * @param viewportHeight viewport height in pixels
+ * @return pixels per unit
+ */
+inline GLfloat screenPixelsPerUnit(GLfloat distance, GLfloat fov, GLfloat viewportHeight)
+{
+	return viewportHeight / (2.f * distance * std::tan(glm::radians(fov) / 2.f));
+}
+
+/**
+ * selects the coarsest level whose projected error stays under the tolerated error; a coarser level is taken only once its error falls under the hysteresis band, the current level is kept while it stays under the tolerated error
+ * @param levels levels from the finest to the coarsest (errors do not decrease)
+ * @param pixelsPerUnit pixels covered by one unit of object space length
+ * @param current level selected last time
+ * @param pixelError tolerated error in pixels
+ * @param hysteresis relative width of the band
+ * @return index of the selected level
+ */
+size_t selectLod(const std::vector<LodLevel>& levels, GLfloat pixelsPerUnit, size_t current, GLfloat pixelError, GLfloat hysteresis = LOD_HYSTERESIS);
\ No newline at end of file
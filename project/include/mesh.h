@@ -1,275 +1,543 @@
-#pragma once
-
-#include "libs.h"
-
-#include "vertex.h"
-#include "pair.h"
-#include "face.h"
-#include "shader.h"
-#include "objLoader.h"
-
-//forward class declaration
-class Gui;
-
-/**
- * mesh class
- */
-class Mesh
-{
-	friend Gui;
-
-	//private variables
-	std::vector<Vertex> _vertices;	/**< vector of vertices*/
-	std::vector<SimpleVertex> _simpleVertices;	/**< vector of simple vertices*/
-
-	std::vector<GLuint> _indices;	/**< vector of vertices ID's in drawing order*/
-	std::vector<GLuint> _simpleIndices;	/**< vector of simple vertices ID's in drawing order*/
-
-	GLdouble _percentage;	/**< destinated quantity in % of output vertices compared to input vertices*/
-
-	double _simplifyTime;	/**< variable for calculating simplifying time*/
-	double _aeapTime;	/**< variable for calculating isotropic remeshing time*/
-
-	//for simplification purposes
-	std::vector<Face> _faces; 	/**< vector of faces*/
-	std::set<Pair> _pairsSet; 	/**< set of edges to preserve duplication*/
-	std::vector<Pair> _pairs;	/**< vector of edges*/
-
-	GLuint _VAO;	/**< vertex array object ID*/
-	GLuint _VBO;	/**< vertex buffer object ID*/
-	GLuint _EBO;	/**< element buffer object ID*/
-	
-	glm::vec3 _position;	/**< position of mesh*/
-	glm::vec3 _origin;	/**< origin point of mesh*/
-	glm::vec3 _rotation;	/**< rotation of mesh*/
-	glm::vec3 _scale;	/**< scale of mesh*/
-	
-	glm::mat4 _ModelMatrix;	/**< model matrix*/
-
-	bool _simple;	/**< if mesh is not simple, draw it with simple vertices and simple indices*/
-	bool _simplify;	/**< run the algotithms if this is true*/
-	GLuint _type;	/**< type of primitives to draw*/
-	
-	//private functions
-	/**
-	 * inits VAO, VBO and EBO
-	 * @param simple checks if mesh is constructed with simple or regular verices
-	 */
-	void init(bool simple);
-
-	/**
-	 * sends model matrix to uniform in shader
-	 * @param shader pointer to shader
-	 */
-	inline void updateUniforms(Shader* shader)
-	{
-		shader->setMat4fv(_ModelMatrix, "ModelMatrix");
-	}
-
-	/**
-	 * updates model matrix for shader
-	 */
-	void updateModelMatrix();
-	
-public:
-
-	/**
-	 * mesh constructor
-	 * @param objLoader loader object to get variables from
-	 * @param type type of primitives
-	 * @param percentage destinated quantity in % of output vertices compared to input vertices
-	 * @param position position of mesh
-	 * @param origin origin of mesh
-	 * @param rotation rotation of mesh
-	 * @param scale scale of mesh
-	 * @param simple if mesh is not simple, draw it with simple vertices and simple indices
-	 * @param simplify run the remeshing algotithms if this is true
-	 */
-	Mesh
-	(
-		ObjLoader objLoader,
-		GLuint type,
-		GLdouble percentage,
-		glm::vec3 position = glm::vec3(.0f),
-		glm::vec3 origin = glm::vec3(.0f),
-		glm::vec3 rotation = glm::vec3(.0f),
-		glm::vec3 scale = glm::vec3(1.f),
-		bool simple = false,
-		bool simplify = false
-	);
-
-	/**
-	 * mesh copy-like constructor
-	 * @param mesh mesh to copy variables from
-	 * @param position position of new mesh
-	 * @param origin origin of new mesh
-	 * @param scale scale of new mesh
-	 */
-	Mesh(const Mesh* mesh, glm::vec3 position, glm::vec3 rotation, glm::vec3 scale);
-
-	/**
-	 * mesh destructor, delete VAO, VBO and EBO
-	 */
-	~Mesh();
-	
-	/**
-	 * position modifier
-	 * @param position new position
-	 */
-	inline void setPosition(const glm::vec3 position)
-	{
-		_position = position;
-	}
-	/**
-	 * origin modifier
-	 * @param origin new origin point
-	 */
-	inline void setOrigin(const glm::vec3 origin)
-	{
-		_origin = origin;
-	}
-	/**
-	 * rotation modifier
-	 * @param rotation new rotation
-	 */
-	inline void setRotation(const glm::vec3 rotation)
-	{
-		_rotation = rotation;
-	}
-	/**
-	 * scale modifier
-	 * @param scale new scale
-	 */
-	inline void setScale(const glm::vec3 scale)
-	{
-		_scale = scale;
-	}
-	
-	/**
-	 * move the mesh
-	 * @param position position vector to add
-	 */
-	inline void move(const glm::vec3 position)
-	{
-		_position += position;
-	}
-	/**
-	 * rotatie the mesh
-	 * @param position rotation vector to add
-	 */
-	inline void rotate(const glm::vec3 rotation)
-	{
-		_rotation += rotation;
-	}
-	/**
-	 * scale the mesh
-	 * @param position scale vector to add
-	 */
-	inline void scaleUp(const glm::vec3 scale)
-	{
-		_scale += scale;
-	}
-
-	/**
-	 * render the mesh
-	 * @param shader pointer to shader to use
-	 * @param polygonMode basically filled/empty triangles
-	 */
-	void render(Shader* shader, int polygonMode);
-
-	
-	//	simplify mesh
-
-	/**
-	 * computes initial quadric for simple vertex
-	 * @param v reference to Simple Vertex object
-	 */
-	void computeInitialQuad(SimpleVertex& v);
-
-	/**
-	 * computes initial cost for every pair
-	 */
-	void computeInitialCost();
-	/**
-	 * computes cost for every pair that contains vertex
-	 * @param vertexId ID of vertex
-	 */
-	void computeCost(GLuint vertexId);
-
-	/**
-	 * returns vertex of given ID
-	 * @param id vertex ID
-	 * @return reference to SimpleVertex object
-	 */
-	SimpleVertex& getVertex(const GLuint id);
-	/**
-	 * returns face of given ID
-	 * @param id face ID
-	 * @return reference to Face object
-	 */
-	Face& getFace(const GLuint id);
-
-	/**
-	 * returns position of vertex in _simpleVertices
-	 * @param id vertex ID
-	 * @return index in _simpleVertices
-	 */
-	GLuint findVertexPosition(const GLuint id);
-	/**
-	 * returns position of face in _faces
-	 * @param id face ID
-	 * @return index in _faces
-	 */
-	GLuint findFacePosition(const GLuint id);
-	/**
-	 * returns position of pair in pairs
-	 * @param id pair ID
-	 * @return index in _pairs
-	 */
-	GLuint findPairPosition(const GLuint id);
-
-	/**
-	 * checks if face contains vertex
-	 * @param faceId face ID
-	 * @param vertexID vertex ID
-	 */
-	bool contains(GLuint faceId, GLuint vertexId);
-
-	/**
-	 * collapses an edge
-	 * @param newId ID of vertex to modify
-	 * @param oldId ID of vertex to delete
-	 */
-	void collapse(GLuint newId, GLuint oldId);
-
-	/**
-	 * quadric error metric simplify algorithm
-	 * @param percentage destinated quantity in % of output vertices compared to input vertices
-	 */
-	void simplifyMesh(GLdouble percentage);
-
-	//as-equilateral-as-possible remeshing (failed)
-	//void aeap();
-	
-	//quasi-regular mesh
-	/**
-	 * splits an edge
-	 * @param pair reference of pair to be splitted
-	 */
-	void split(Pair& pair);
-	/**
-	 * flips an edge
-	 * @param pair reference of pair to be flipped
-	 */
-	void flip(Pair& pair);
-	/**
-	 * relocates a vertex using average position of neighbors
-	 * @param pair reference of pair to be flipped
-	 */
-	void vertexRelocation(SimpleVertex& vertex);
-
-	/**
-	 * isotropic remeshing alorithm
-	 */
-	void incrementalRemeshing();
-};
+#pragma once
+
+#include "libs.h"
+
+#include "vertex.h"
+#include "pair.h"
+#include "face.h"
+#include "simplifyTarget.h"
+#include "remeshTarget.h"
+#include "parallel.h"
+#include "adjacency.h"
+#include "edgeTable.h"
+#include "arena.h"
+#include "vertexStreams.h"
+#include "bvh.h"
+#include "deviation.h"
+#include "vertexFormat.h"
+#include "vertexCache.h"
+#include "indexFormat.h"
+#include "streamBuffer.h"
+#include "cluster.h"
+#include "shader.h"
+#include "objLoader.h"
+
+//forward class declaration
+class Gui;
+class BatchRenderer;
+
+const GLfloat COLLAPSE_FLIP_LIMIT = .2f;	/**< lowest cosine between face normals before and after a collapse*/
+const GLfloat COLLAPSE_PENALTY = 4.f;	/**< priority multiplier of a rejected collapse put back into the queue (its cost is kept)*/
+const GLuint COLLAPSE_MAX_REJECTIONS = 4;	/**< rejections after which a pair is dropped from the queue*/
+const bool QUANTIZE_ATTRIBUTES = true;	/**< shaded meshes upload 16-bit positions, 8-bit colors, half float texcoords and octahedral normals*/
+const GLuint PREVIEW_COLLAPSES = 256;	/**< collapses between checks whether a preview frame is due*/
+const GLdouble PREVIEW_INTERVAL = 1.0 / 30.0;	/**< shortest time between preview frames in seconds*/
+
+/**
+ * mesh class
+ */
+class Mesh
+{
+	friend Gui;
+	friend BatchRenderer;
+
+	//private variables
+	std::vector<Vertex> _vertices;	/**< vector of vertices*/
+	std::vector<SimpleVertex> _simpleVertices;	/**< vector of simple vertices*/
+
+	std::vector<GLuint> _indices;	/**< vector of vertices ID's in drawing order*/
+	std::vector<GLuint> _simpleIndices;	/**< vector of simple vertices ID's in drawing order*/
+
+	std::vector<Vertex> _wedges;	/**< attribute vertices referenced by faces' corners, merged during simplification*/
+	GLfloat _attributeScale = .0f;	/**< scale of attribute error, so it is comparable with squared distances*/
+
+	SimplifyTarget _target;	/**< stopping criteria of the simplification*/
+
+	double _simplifyTime;	/**< variable for calculating simplifying time*/
+	double _aeapTime;	/**< variable for calculating isotropic remeshing time*/
+	RemeshTarget _remeshTarget;	/**< settings of the isotropic remeshing*/
+	GLdouble _remeshLength = 0.0;	/**< target edge length used by the isotropic remeshing*/
+	std::vector<RemeshIteration> _remeshLog;	/**< reports of remeshing iterations (the first one describes the input mesh)*/
+	size_t _remeshBest = 0;	/**< iteration whose mesh was kept (0 - input mesh, no iteration completed)*/
+	Bvh _reference;	/**< input surface of the remeshing, relocated vertices are projected back onto it*/
+	GLfloat _simplifyError = .0f;	/**< highest quadric error of all performed collapses*/
+	SurfaceDeviation _simplifyDeviation;	/**< deviation between the input and the simplified surface*/
+	SurfaceDeviation _remeshDeviation;	/**< deviation between the input and the remeshed surface*/
+
+	//for simplification purposes
+	std::vector<Face> _faces; 	/**< vector of faces*/
+	Adjacency _vertexFaces;	/**< static vertex -> faces adjacency of the input mesh (CSR), freed once the initial quadrics are computed*/
+	Arena _scratch;	/**< scratch memory of a single operation (collapse, split, flip), reset when the next one starts*/
+	std::vector<Pair> _pairs;	/**< vector of edges*/
+	std::priority_queue<PairEntry, std::vector<PairEntry>, std::greater<PairEntry>> _pairsQueue;	/**< min-heap of pairs ordered by priority (cost with penalties)*/
+	std::vector<GLuint> _stamps;	/**< modification counters of vertices (indexed by vertex ID), used to detect stale queue entries*/
+	VertexStreams _streams;	/**< structure-of-arrays copy of simple vertices for iterated passes (relaxation, sizing field) and projection*/
+	VertexStreams _ring;	/**< structure-of-arrays copy of a collapsed vertex and its neighbors for re-costing*/
+	std::vector<GLfloat> _costs;	/**< costs of all pairs computed by one pass*/
+
+	GLuint _VAO;	/**< vertex array object ID*/
+	GLuint _VBO;	/**< vertex buffer object ID*/
+	GLuint _EBO;	/**< element buffer object ID*/
+	size_t _vertexBufferBytes = 0;	/**< size of the uploaded vertex buffer*/
+	VertexDequantization _dequantization;	/**< shader parameters decoding the uploaded vertices*/
+	QuantizationError _quantizationError;	/**< quality loss of the uploaded vertices*/
+	VertexCacheStats _cacheBefore;	/**< vertex cache efficiency of the index order before optimization*/
+	VertexCacheStats _cacheAfter;	/**< vertex cache efficiency of the uploaded index order*/
+	GLenum _indexType = GL_UNSIGNED_INT;	/**< type of the uploaded indices*/
+	size_t _indexBufferBytes = 0;	/**< size of the uploaded index buffer*/
+	size_t _compressedIndexBytes = 0;	/**< size of the indices encoded by encodeIndices (on-disk format)*/
+
+	//visibility culling of the uploaded triangles
+	BoundingSphere _bounds;	/**< object space bounding sphere of the drawn vertices*/
+	std::vector<Cluster> _clusters;	/**< clusters of the uploaded index buffer*/
+	std::vector<GLsizei> _drawCounts;	/**< index counts of visible cluster runs*/
+	std::vector<const GLvoid*> _drawOffsets;	/**< byte offsets of visible cluster runs*/
+	bool _culled = false;	/**< the next render draws the visible runs only*/
+	size_t _visibleClusters = 0;	/**< number of clusters which passed the last cull*/
+	size_t _visibleTriangles = 0;	/**< number of triangles which passed the last cull*/
+
+	//live preview of a running simplification or remeshing
+	static std::function<void(Mesh*)> _preview;	/**< draws a frame with the mesh being processed (set by GUI, empty - no preview)*/
+	std::chrono::steady_clock::time_point _lastPreview;	/**< time of the last preview frame*/
+	GLuint _streamVAO = 0;	/**< vertex array object ID of the preview*/
+	StreamBuffer _streamVertices;	/**< preview positions*/
+	StreamBuffer _streamIndices;	/**< preview indices*/
+	GLsizei _streamCount = 0;	/**< number of preview indices*/
+	
+	glm::vec3 _position;	/**< position of mesh*/
+	glm::vec3 _origin;	/**< origin point of mesh*/
+	glm::vec3 _rotation;	/**< rotation of mesh*/
+	glm::vec3 _scale;	/**< scale of mesh*/
+	
+	glm::mat4 _ModelMatrix;	/**< model matrix*/
+
+	bool _simple;	/**< if mesh is not simple, draw it with simple vertices and simple indices*/
+	bool _simplify;	/**< run the algotithms if this is true*/
+	GLuint _type;	/**< type of primitives to draw*/
+	
+	//private functions
+	/**
+	 * inits VAO, VBO and EBO with the geometry of exportGeometry
+	 * @param simple checks if mesh is constructed with simple or regular verices (simple meshes upload positions only)
+	 */
+	void init(bool simple);
+	/**
+	 * computes the bounding sphere and clusters of the uploaded geometry
+	 * @param simple checks if mesh is constructed with simple or regular verices (simple meshes get no normal cones)
+	 * @param indices uploaded indices
+	 * @param remap uploaded position of every vertex (empty - vertices were not reordered)
+	 */
+	void initClusters(bool simple, const std::vector<GLuint>& indices, const std::vector<GLuint>& remap);
+
+	/**
+	 * writes positions and triangles of the current state into the next regions of stream buffers
+	 */
+	void streamUpload();
+	/**
+	 * uploads the current state and lets GUI draw it, at most once per PREVIEW_INTERVAL
+	 */
+	void preview();
+	/**
+	 * deletes the preview VAO and stream buffers
+	 */
+	void releaseStream();
+
+	/**
+	 * sends model matrix to uniform in shader
+	 * @param shader pointer to shader
+	 */
+	inline void updateUniforms(Shader* shader)
+	{
+		shader->setMat4fv(_ModelMatrix, "ModelMatrix");
+		shader->setVec3f(_dequantization._positionOffset, "PositionOffset");
+		shader->setVec3f(_dequantization._positionScale, "PositionScale");
+		shader->set1i(_dequantization._octahedralNormals, "OctahedralNormals");
+	}
+
+	/**
+	 * updates model matrix for shader
+	 */
+	void updateModelMatrix();
+	
+public:
+
+	/**
+	 * mesh constructor
+	 * @param objLoader loader object to get variables from
+	 * @param type type of primitives
+	 * @param target stopping criteria of the simplification (or destinated quantity in % of output vertices compared to input vertices)
+	 * @param position position of mesh
+	 * @param origin origin of mesh
+	 * @param rotation rotation of mesh
+	 * @param scale scale of mesh
+	 * @param simple if mesh is not simple, draw it with simple vertices and simple indices
+	 * @param simplify run the remeshing algotithms if this is true
+	 */
+	Mesh
+	(
+		ObjLoader objLoader,
+		GLuint type,
+		SimplifyTarget target,
+		glm::vec3 position = glm::vec3(.0f),
+		glm::vec3 origin = glm::vec3(.0f),
+		glm::vec3 rotation = glm::vec3(.0f),
+		glm::vec3 scale = glm::vec3(1.f),
+		bool simple = false,
+		bool simplify = false
+	);
+
+	/**
+	 * mesh copy-like constructor
+	 * @param mesh mesh to copy variables from
+	 * @param position position of new mesh
+	 * @param origin origin of new mesh
+	 * @param scale scale of new mesh
+	 * @param target settings of the isotropic remeshing
+	 */
+	Mesh(const Mesh* mesh, glm::vec3 position, glm::vec3 rotation, glm::vec3 scale, const RemeshTarget& target = RemeshTarget());
+
+	/**
+	 * mesh constructor drawing simplified geometry of another mesh with all vertex attributes
+	 * @param mesh simplified mesh to take attribute buffers from
+	 */
+	explicit Mesh(const Mesh* mesh);
+
+	/**
+	 * mesh destructor, delete VAO, VBO and EBO
+	 */
+	~Mesh();
+	
+	/**
+	 * position modifier
+	 * @param position new position
+	 */
+	inline void setPosition(const glm::vec3 position)
+	{
+		_position = position;
+	}
+	/**
+	 * origin modifier
+	 * @param origin new origin point
+	 */
+	inline void setOrigin(const glm::vec3 origin)
+	{
+		_origin = origin;
+	}
+	/**
+	 * rotation modifier
+	 * @param rotation new rotation
+	 */
+	inline void setRotation(const glm::vec3 rotation)
+	{
+		_rotation = rotation;
+	}
+	/**
+	 * scale modifier
+	 * @param scale new scale
+	 */
+	inline void setScale(const glm::vec3 scale)
+	{
+		_scale = scale;
+	}
+	
+	/**
+	 * move the mesh
+	 * @param position position vector to add
+	 */
+	inline void move(const glm::vec3 position)
+	{
+		_position += position;
+	}
+	/**
+	 * rotatie the mesh
+	 * @param position rotation vector to add
+	 */
+	inline void rotate(const glm::vec3 rotation)
+	{
+		_rotation += rotation;
+	}
+	/**
+	 * scale the mesh
+	 * @param position scale vector to add
+	 */
+	inline void scaleUp(const glm::vec3 scale)
+	{
+		_scale += scale;
+	}
+
+	/**
+	 * render the mesh
+	 * @param shader pointer to shader to use
+	 * @param polygonMode basically filled/empty triangles
+	 */
+	void render(Shader* shader, int polygonMode);
+	/**
+	 * tests clusters against the view frustum and the camera, the next render draws the visible ones only
+	 * @param viewProjection projection * view matrix
+	 * @param camera camera position in world space
+	 * @param polygonMode clusters facing away are skipped for filled triangles only, lines behind the surface stay visible
+	 */
+	void cull(const glm::mat4& viewProjection, const glm::vec3& camera, int polygonMode);
+	/**
+	 * packed export of the vertices read by the shader and their indices, triangles are reordered for the vertex cache and vertices in order of their first use
+	 * @param simple positions only
+	 * @param indices indices of the packed vertices
+	 * @param remap new position of every vertex, optional (empty if vertices were not reordered)
+	 * @return packed vertices
+	 */
+	PackedVertices exportGeometry(bool simple, std::vector<GLuint>& indices, std::vector<GLuint>* remap = nullptr) const;
+	/**
+	 * writes the uploaded indices into a compressed index file (saveIndices) and reads them back
+	 * @param fileName file name
+	 * @return false if the file can not be written or does not decode to the same indices
+	 */
+	bool exportIndices(const char* fileName) const;
+	/**
+	 * number of clusters getter
+	 * @return number of clusters
+	 */
+	inline size_t getClusterCount() const { return _clusters.size(); }
+	/**
+	 * visible clusters getter
+	 * @return number of clusters which passed the last cull
+	 */
+	inline size_t getVisibleClusters() const { return _visibleClusters; }
+	/**
+	 * visible triangles getter
+	 * @return number of triangles which passed the last cull
+	 */
+	inline size_t getVisibleTriangles() const { return _visibleTriangles; }
+	/**
+	 * model matrix getter
+	 * @return model matrix
+	 */
+	inline const glm::mat4& getModelMatrix() const { return _ModelMatrix; }
+	/**
+	 * geometric error of the mesh as a level of detail (0 for meshes that were not simplified)
+	 * @return Hausdorff distance between the input and the simplified surface
+	 */
+	inline GLfloat getLodError() const { return static_cast<GLfloat>(_simplifyDeviation.hausdorff()); }
+	/**
+	 * memory of the topology: neighbor and face rings of all vertices with their heap chunks, and the static CSR while it is alive
+	 * @return number of bytes
+	 */
+	size_t adjacencyBytes() const;
+	/**
+	 * render the state uploaded by the last preview
+	 * @param shader pointer to shader to use
+	 * @param polygonMode basically filled/empty triangles
+	 */
+	void renderStream(Shader* shader, int polygonMode);
+
+	
+	//	simplify mesh
+
+	/**
+	 * computes initial quadric for simple vertex
+	 * @param v reference to Simple Vertex object
+	 */
+	void computeInitialQuad(SimpleVertex& v);
+
+	/**
+	 * pushes pair to the priority queue with current stamps of its vertices
+	 * @param pair reference to Pair object
+	 */
+	void pushPair(const Pair& pair);
+	/**
+	 * checks if queue entry is still up to date
+	 * @param entry reference to PairEntry object
+	 * @return boolean value
+	 */
+	inline bool isValid(const PairEntry& entry)
+	{
+		return _stamps[entry._vertices[0]] == entry._stamps[0] && _stamps[entry._vertices[1]] == entry._stamps[1];
+	}
+
+	/**
+	 * adds constraint planes perpendicular to faces along boundary and attribute seam edges to the quadrics
+	 * @param edges unique edges of the input mesh with their faces
+	 * @param weight weight of constraint planes
+	 */
+	void computeConstraintQuads(const EdgeTable& edges, GLfloat weight);
+
+	/**
+	 * computes initial cost for every pair and fills the priority queue
+	 */
+	void computeInitialCost();
+	/**
+	 * computes cost for every pair that contains vertex (one batch over its ring) and pushes it to the priority queue
+	 * @param vertexId ID of vertex
+	 */
+	void computeCost(GLuint vertexId);
+
+	/**
+	 * returns vertex of given ID
+	 * @param id vertex ID
+	 * @return reference to SimpleVertex object
+	 */
+	SimpleVertex& getVertex(const GLuint id);
+	/**
+	 * returns face of given ID
+	 * @param id face ID
+	 * @return reference to Face object
+	 */
+	Face& getFace(const GLuint id);
+
+	/**
+	 * returns position of vertex in _simpleVertices
+	 * @param id vertex ID
+	 * @return index in _simpleVertices
+	 */
+	GLuint findVertexPosition(const GLuint id);
+	/**
+	 * returns position of face in _faces
+	 * @param id face ID
+	 * @return index in _faces
+	 */
+	GLuint findFacePosition(const GLuint id);
+	/**
+	 * returns position of pair in pairs
+	 * @param id pair ID
+	 * @return index in _pairs
+	 */
+	GLuint findPairPosition(const GLuint id);
+
+	/**
+	 * checks if face contains vertex
+	 * @param faceId face ID
+	 * @param vertexID vertex ID
+	 */
+	bool contains(GLuint faceId, GLuint vertexId);
+
+	/**
+	 * checks if collapsing an edge into its midpoint keeps the mesh manifold (link condition) and does not fold any face
+	 * @param newId ID of vertex to modify
+	 * @param oldId ID of vertex to delete
+	 * @return boolean value
+	 */
+	bool isCollapseValid(GLuint newId, GLuint oldId);
+	/**
+	 * collapses an edge (pairs are not updated)
+	 * @param newId ID of vertex to modify
+	 * @param oldId ID of vertex to delete
+	 */
+	void collapse(GLuint newId, GLuint oldId);
+
+	/**
+	 * merges attribute vertices of collapsed edge (wedges on the same side of a removed face are averaged)
+	 * @param newId ID of vertex to modify
+	 * @param oldId ID of vertex to delete
+	 * @param removedFaces IDs of faces removed by the collapse
+	 */
+	void collapseWedges(GLuint newId, GLuint oldId, const ArenaVector<GLuint>& removedFaces);
+	/**
+	 * builds _vertices and _indices (full attributes) from simplified faces and wedges
+	 */
+	void buildAttributeBuffers();
+
+	/**
+	 * quadric error metric simplify algorithm
+	 * @param target stopping criteria (vertex ratio, highest quadric error, triangle count)
+	 */
+	void simplifyMesh(const SimplifyTarget& target);
+
+	/**
+	 * builds static CSR adjacency and fills mutable neighbor and face rings of all vertices (vertex and face IDs must be equal to their positions)
+	 */
+	void buildAdjacency();
+	/**
+	 * rebuilds neighbors, faces of vertices and pairs from _faces (vertex IDs must be equal to their positions)
+	 */
+	void buildTopology();
+	/**
+	 * grid vertex clustering simplify algorithm; vertices are merged per cell and placed at the minimum of the cell's quadric
+	 * @param target stopping criteria (grid resolution or vertex ratio/triangle count/error used to derive it)
+	 */
+	void clusterMesh(const SimplifyTarget& target);
+
+	//as-equilateral-as-possible remeshing (failed)
+	//void aeap();
+	
+	//quasi-regular mesh
+	/**
+	 * splits an edge
+	 * @param position position of pair to be splitted in _pairs (new pairs are appended, so no reference is kept)
+	 */
+	void split(size_t position);
+	/**
+	 * flips an edge if it lowers the valence deviation of the four vertices (6 inside, 4 on the boundary) and folds no face
+	 * @param e1 ID of first vertex of the edge
+	 * @param e2 ID of second vertex of the edge
+	 * @return true if the edge was flipped
+	 */
+	bool flip(GLuint e1, GLuint e2);
+	/**
+	 * flips edges until no flip improves valence; every flip queues the four surrounding edges again, pairs are rebuilt afterwards
+	 * @return number of flips
+	 */
+	size_t flipEdges();
+	/**
+	 * rebuilds pairs from neighbors of vertices
+	 */
+	void buildPairs();
+	/**
+	 * relocates all vertices towards average position of neighbors within their tangent planes (positions before every iteration are used, vertices are processed in parallel)
+	 * @param iterations number of smoothing iterations
+	 */
+	void vertexRelocation(GLuint iterations);
+	/**
+	 * copies positions of simple vertices and faces as vertex positions
+	 * @param positions output vector of positions
+	 * @param triangles output vector of triangles
+	 */
+	void gatherTriangles(std::vector<glm::vec3>& positions, std::vector<std::array<GLuint, 3>>& triangles);
+	/**
+	 * builds the reference surface from current vertices and faces
+	 */
+	void buildReference();
+	/**
+	 * moves all vertices to their closest points on the reference surface (batched, in parallel)
+	 */
+	void projectVertices();
+
+	/**
+	 * sets target edge lengths of all vertices; the adaptive field is computed from curvature of the current mesh
+	 * @param length target edge length
+	 */
+	void computeSizingField(GLdouble length);
+	/**
+	 * target length of an edge, mean of the sizing field at both vertices
+	 * @param a reference to first vertex
+	 * @param b reference to second vertex
+	 * @return length
+	 */
+	inline GLdouble targetLength(const SimpleVertex& a, const SimpleVertex& b)
+	{
+		return .5 * (a._size + b._size);
+	}
+	/**
+	 * checks if collapsing an edge into its midpoint leaves all edges around it short enough not to be split again
+	 * @param newId ID of vertex to modify
+	 * @param oldId ID of vertex to delete
+	 * @return boolean value
+	 */
+	bool isCollapseShort(GLuint newId, GLuint oldId);
+	/**
+	 * fills edge length histogram of the current mesh (lengths relative to the sizing field)
+	 * @param iteration report to fill
+	 */
+	void measureEdgeLengths(RemeshIteration& iteration);
+	/**
+	 * one collapse/split/flip/relocation pass; the time is checked between operations, so the mesh stays valid when it runs out
+	 * @param deadline time point at which the pass stops
+	 * @param iteration report to fill
+	 * @return false if the time ran out
+	 */
+	bool remeshIteration(std::chrono::steady_clock::time_point deadline, RemeshIteration& iteration);
+
+	/**
+	 * isotropic remeshing alorithm; iterates until the iteration count is reached, the edge length histogram converges or the time runs out, then keeps the completed iteration with most edges in the target range
+	 * @param target settings of the remeshing
+	 */
+	void incrementalRemeshing(const RemeshTarget& target);
+};
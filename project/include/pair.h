@@ -1,53 +1,74 @@
-#pragma once
-
-#include "libs.h"
-
-/**
- * mesh edge class
- */
-struct Pair
-{
-	GLuint _id;
-	std::array<GLuint, 2> _vertices; /**< indexes should be sorted increasingly*/
-	GLfloat _cost = .0f; /**< used in QEM algorithm*/
-
-	/*
-	 * default constructor
-	 */
-	inline Pair() {}
-	/*
-	 * constructor with a sort operation
-	 * @param v1 index1
-	 * @param v2 index2
-	 */
-	inline Pair(GLuint v1, GLuint v2)
-	{
-		v1 < v2 ? _vertices = { v1, v2 } : _vertices = { v2, v1 };
-	}
-	/*
-	 * like above, but with adding cost value
-	 * @param v1 index1
-	 * @param v2 index2
-	 * @param cost cost
-	 */
-	inline Pair(GLuint v1, GLuint v2, GLfloat cost) : _cost(cost)
-	{
-		v1 < v2 ? _vertices = { v1, v2 } : _vertices = { v2, v1 };
-	}
-
-	/*
-	 * needed for std::set's insert method
-	 * @param p reference to another Pair object
-	 * @return boolean value
-	 */
-	inline bool operator<(Pair const &p) const {
-		return _vertices[0] < p._vertices[0] || (_vertices[0] == p._vertices[0] && _vertices[1] < p._vertices[1]);
-	}
-
-	/*
-	 * an ordinary setter
-	 * @param v1 index1
-	 * @param v2 index2
-	 */
-	void set(GLuint v1, GLuint v2);
+#pragma once
+
+#include "libs.h"
+
+/**
+ * mesh edge class
+ */
+struct Pair
+{
+	GLuint _id;
+	std::array<GLuint, 2> _vertices; /**< indexes should be sorted increasingly*/
+	GLfloat _cost = .0f; /**< used in QEM algorithm*/
+
+	/*
+	 * default constructor
+	 */
+	inline Pair() {}
+	/*
+	 * constructor with a sort operation
+	 * @param v1 index1
+	 * @param v2 index2
+	 */
+	inline Pair(GLuint v1, GLuint v2)
+	{
+		v1 < v2 ? _vertices = { v1, v2 } : _vertices = { v2, v1 };
+	}
+	/*
+	 * like above, but with adding cost value
+	 * @param v1 index1
+	 * @param v2 index2
+	 * @param cost cost
+	 */
+	inline Pair(GLuint v1, GLuint v2, GLfloat cost) : _cost(cost)
+	{
+		v1 < v2 ? _vertices = { v1, v2 } : _vertices = { v2, v1 };
+	}
+
+	/*
+	 * needed for std::set's insert method
+	 * @param p reference to another Pair object
+	 * @return boolean value
+	 */
+	inline bool operator<(Pair const &p) const {
+		return _vertices[0] < p._vertices[0] || (_vertices[0] == p._vertices[0] && _vertices[1] < p._vertices[1]);
+	}
+
+	/*
+	 * an ordinary setter
+	 * @param v1 index1
+	 * @param v2 index2
+	 */
+	void set(GLuint v1, GLuint v2);
+};
+
+/**
+ * entry of the pairs priority queue; entries are never removed, they become stale when one of their vertices changes
+ */
+struct PairEntry
+{
+	GLfloat _cost;	/**< cost of contracting the pair (quadric error)*/
+	GLfloat _priority;	/**< heap key, the cost raised by penalties of rejected collapses*/
+	std::array<GLuint, 2> _vertices;	/**< vertices of the pair*/
+	std::array<GLuint, 2> _stamps;	/**< vertices' stamps at the time of pushing*/
+	GLuint _rejections = 0;	/**< how many times the collapse was rejected by topology checks*/
+
+	/*
+	 * needed for min-heap ordering
+	 * @param e reference to another PairEntry object
+	 * @return boolean value
+	 */
+	inline bool operator>(PairEntry const &e) const {
+		return _priority > e._priority;
+	}
 };
\ No newline at end of file
@@ -0,0 +1,142 @@
+#pragma once
+
+#include "libs.h"
+
+/**
+ * minimal number of iterations given to a single thread
+ */
+const size_t PARALLEL_GRAIN = 1024;
+
+/**
+ * returns number of threads used for given number of iterations
+ * @param count number of iterations
+ * @param grain minimal number of iterations of a single thread
+ * @return number of threads
+ */
+inline size_t parallelThreads(size_t count, size_t grain = PARALLEL_GRAIN)
+{
+	size_t threads = std::max<size_t>(1, std::thread::hardware_concurrency());
+	return std::max<size_t>(1, std::min(threads, count / grain));
+}
+
+/**
+ * calls func(chunkBegin, chunkEnd, thread) for contiguous chunks of [begin, end), one chunk per thread
+ * @param begin first index
+ * @param end one past the last index
+ * @param func function to call
+ * @param grain minimal number of iterations of a single thread (1 for expensive iterations)
+ */
+template <typename Func>
+inline void parallelChunks(size_t begin, size_t end, Func func, size_t grain = PARALLEL_GRAIN)
+{
+	if (end <= begin)
+		return;
+
+	size_t count = end - begin;
+	size_t threads = parallelThreads(count, grain);
+	if (threads == 1)
+	{
+		func(begin, end, static_cast<size_t>(0));
+		return;
+	}
+
+	size_t chunk = (count + threads - 1) / threads;
+	std::vector<std::thread> pool;
+	for (size_t t = 0; t < threads; ++t)
+	{
+		size_t chunkBegin = begin + t * chunk;
+		size_t chunkEnd = std::min(end, chunkBegin + chunk);
+		if (chunkBegin >= chunkEnd)
+			break;
+		pool.emplace_back([&func, chunkBegin, chunkEnd, t]() { func(chunkBegin, chunkEnd, t); });
+	}
+	for (auto& t : pool)
+		t.join();
+}
+
+/**
+ * calls func(i) for every i in [begin, end) on all hardware threads
+ * @param begin first index
+ * @param end one past the last index
+ * @param func function to call
+ * @param grain minimal number of iterations of a single thread (1 for expensive iterations)
+ */
+template <typename Func>
+inline void parallelFor(size_t begin, size_t end, Func func, size_t grain = PARALLEL_GRAIN)
+{
+	parallelChunks(begin, end, [&func](size_t chunkBegin, size_t chunkEnd, size_t)
+	{
+		for (size_t i = chunkBegin; i < chunkEnd; ++i)
+			func(i);
+	}, grain);
+}
+
+/**
+ * calls func(task) for every task in [0, count), each on its own thread (the first one on the calling thread)
+ * @param count number of tasks
+ * @param func function to call
+ */
+template <typename Func>
+inline void parallelTasks(size_t count, Func func)
+{
+	std::vector<std::thread> pool;
+	for (size_t t = 1; t < count; ++t)
+		pool.emplace_back([&func, t]() { func(t); });
+	if (count > 0)
+		func(0);
+	for (auto& t : pool)
+		t.join();
+}
+
+/**
+ * stable LSD radix sort by 64-bit keys, 11 bits per pass; histograms and scatters run per thread on contiguous chunks, passes in which all keys share the digit are skipped
+ * @param values vector to sort
+ * @param key function returning key of value
+ */
+template <typename T, typename Key>
+inline void parallelRadixSort(std::vector<T>& values, Key key)
+{
+	const size_t BITS = 11;
+	const size_t BUCKETS = size_t(1) << BITS;
+
+	size_t n = values.size();
+	size_t threads = parallelThreads(n);
+	std::vector<T> buffer(n);
+	std::vector<size_t> counts(threads * BUCKETS);
+
+	for (size_t shift = 0; shift < 64; shift += BITS)
+	{
+		auto digit = [&key, shift, BUCKETS](const T& value) { return static_cast<size_t>(key(value) >> shift) & (BUCKETS - 1); };
+
+		//histogram of every chunk
+		std::fill(counts.begin(), counts.end(), 0);
+		parallelChunks(0, n, [&](size_t chunkBegin, size_t chunkEnd, size_t thread)
+		{
+			size_t* c = counts.data() + thread * BUCKETS;
+			for (size_t i = chunkBegin; i < chunkEnd; ++i)
+				++c[digit(values[i])];
+		});
+
+		//offsets: bucket by bucket, chunk by chunk (keeps the sort stable)
+		size_t offset = 0;
+		bool trivial = false;
+		for (size_t d = 0; d < BUCKETS; ++d)
+			for (size_t t = 0; t < threads; ++t)
+			{
+				size_t c = counts[t * BUCKETS + d];
+				trivial = trivial || c == n;
+				counts[t * BUCKETS + d] = offset;
+				offset += c;
+			}
+		if (trivial)
+			continue;
+
+		parallelChunks(0, n, [&](size_t chunkBegin, size_t chunkEnd, size_t thread)
+		{
+			size_t* c = counts.data() + thread * BUCKETS;
+			for (size_t i = chunkBegin; i < chunkEnd; ++i)
+				buffer[c[digit(values[i])]++] = values[i];
+		});
+		values.swap(buffer);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,94 @@
+#pragma once
+
+#include "libs.h"
+
+const GLuint RELAXATION_ITERATIONS = 3;	/**< tangential smoothing iterations per remeshing pass*/
+const GLdouble REMESH_MIN_RATIO = 4.0 / 5.0;	/**< edges shorter than this times the target length are collapsed*/
+const GLdouble REMESH_MAX_RATIO = 4.0 / 3.0;	/**< edges longer than this times the target length are split*/
+const size_t REMESH_HISTOGRAM_BINS = 30;	/**< bins of the edge length histogram, 1/15 of the local target length wide (both ratios fall on bin borders), the last one takes all longer edges*/
+
+/**
+ * settings of the isotropic remeshing; iterations stop when the count is reached, the edge length histogram converges or the time runs out
+ */
+struct RemeshTarget
+{
+	GLdouble _edgeLength = 0.0;	/**< target edge length (0 - average edge length of the input mesh)*/
+	GLuint _iterations = 5;	/**< highest number of collapse/split/flip/relocation iterations*/
+	GLfloat _tolerance = .05f;	/**< iterations stop when the normalized histogram changes by less than this (L1 distance, < 0 - disabled)*/
+	GLdouble _timeBudget = 0.0;	/**< wall-clock budget in seconds (0 - unlimited); the best remeshed mesh so far is kept when it runs out*/
+	GLuint _relaxationIterations = RELAXATION_ITERATIONS;	/**< tangential smoothing iterations per remeshing iteration*/
+	bool _project = true;	/**< relocated vertices are projected back onto the input surface*/
+
+	bool _adaptive = false;	/**< target edge length follows curvature (sizing field) instead of being the same everywhere*/
+	GLfloat _adaptiveError = .2f;	/**< tolerated distance between edges and the curved surface, relative to the target edge length*/
+	GLfloat _minScale = .25f;	/**< shortest adaptive edge length relative to the target edge length*/
+	GLfloat _maxScale = 2.f;	/**< longest adaptive edge length relative to the target edge length*/
+	GLuint _sizeSmoothing = 2;	/**< averaging iterations of the sizing field*/
+
+	/**
+	 * default constructor, average edge length of the input and default iterations
+	 */
+	inline RemeshTarget() {}
+	/**
+	 * edge length constructor
+	 * @param edgeLength target edge length (0 - average edge length of the input mesh)
+	 * @param iterations highest number of iterations
+	 * @param timeBudget wall-clock budget in seconds (0 - unlimited)
+	 */
+	inline RemeshTarget(GLdouble edgeLength, GLuint iterations, GLdouble timeBudget = 0.0) : _edgeLength(edgeLength), _iterations(iterations), _timeBudget(timeBudget) {}
+
+	/**
+	 * switches to the curvature-adaptive sizing field
+	 * @param error tolerated distance between edges and the surface relative to the target edge length
+	 * @param minScale shortest edge length relative to the target edge length
+	 * @param maxScale longest edge length relative to the target edge length
+	 * @return reference to this object
+	 */
+	inline RemeshTarget& adaptive(GLfloat error = .2f, GLfloat minScale = .25f, GLfloat maxScale = 2.f)
+	{
+		_adaptive = true;
+		_adaptiveError = error;
+		_minScale = minScale;
+		_maxScale = maxScale;
+		return *this;
+	}
+};
+
+/**
+ * report of a single remeshing iteration
+ */
+struct RemeshIteration
+{
+	double _collapseTime = 0.0;	/**< time of collapsing short edges in seconds*/
+	double _splitTime = 0.0;	/**< time of splitting long edges in seconds*/
+	double _flipTime = 0.0;	/**< time of flipping edges in seconds*/
+	double _relocationTime = 0.0;	/**< time of vertex relocation in seconds*/
+	double _projectionTime = 0.0;	/**< time of projection onto the input surface in seconds*/
+
+	size_t _collapses = 0;	/**< number of collapsed edges*/
+	size_t _splits = 0;	/**< number of split edges*/
+	size_t _flips = 0;	/**< number of flipped edges*/
+
+	std::array<GLfloat, REMESH_HISTOGRAM_BINS> _histogram = {};	/**< fractions of edges per length bin after the iteration*/
+	GLfloat _inRange = .0f;	/**< fraction of edges neither collapsed nor split by another iteration (lengths relative to the sizing field)*/
+	bool _complete = true;	/**< false if the time ran out during the iteration*/
+
+	/**
+	 * time of the whole iteration
+	 * @return time in seconds
+	 */
+	inline double time() const { return _collapseTime + _splitTime + _flipTime + _relocationTime + _projectionTime; }
+
+	/**
+	 * L1 distance of histograms
+	 * @param other reference to another iteration
+	 * @return distance (0 - same distribution, 2 - disjoint)
+	 */
+	inline GLfloat histogramDistance(const RemeshIteration& other) const
+	{
+		GLfloat distance = .0f;
+		for (size_t i = 0; i < REMESH_HISTOGRAM_BINS; ++i)
+			distance += std::abs(_histogram[i] - other._histogram[i]);
+		return distance;
+	}
+};
\ No newline at end of file
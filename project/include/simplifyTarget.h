@@ -0,0 +1,120 @@
+#pragma once
+
+#include "libs.h"
+
+#include "lod.h"
+
+/**
+ * enum containing simplification algorithms
+ */
+enum simplifyMode
+{
+	QEM = 0,	/**< quadric error metric edge collapse (accurate, sequential)*/
+	CLUSTERING	/**< grid vertex clustering with per-cell quadrics (fast, preview quality)*/
+};
+
+/**
+ * stopping criteria of the QEM simplification; simplification stops as soon as any of the enabled criteria is met
+ */
+struct SimplifyTarget
+{
+	GLdouble _percentage = 0.0;	/**< destinated quantity of output vertices compared to input vertices (0 - simplify as far as possible, < 0 - disabled)*/
+	GLfloat _maxError = -1.f;	/**< highest quadric error (squared distance) of a single collapse (< 0 - disabled)*/
+	size_t _targetFaces = 0;	/**< destinated quantity of output triangles (0 - disabled)*/
+
+	GLfloat _attributeWeight = 1.f;	/**< weight of attribute (normal, texcoord, color) error relative to geometric error (0 - geometry only)*/
+	GLfloat _boundaryWeight = 100.f;	/**< weight of constraint planes along boundary and seam edges*/
+
+	simplifyMode _mode = QEM;	/**< simplification algorithm*/
+	GLuint _gridResolution = 0;	/**< clustering cells along the longest bounding box axis (0 - derived from the criteria above)*/
+
+	/**
+	 * default constructor, simplifies as far as possible
+	 */
+	inline SimplifyTarget() {}
+	/**
+	 * vertex ratio constructor (implicit, so percentage can still be passed everywhere)
+	 * @param percentage destinated quantity of output vertices compared to input vertices
+	 */
+	inline SimplifyTarget(GLdouble percentage) : _percentage(percentage) {}
+	/**
+	 * error and budget constructor
+	 * @param maxError highest quadric error of a single collapse (< 0 - disabled)
+	 * @param targetFaces destinated quantity of output triangles (0 - disabled)
+	 */
+	inline SimplifyTarget(GLfloat maxError, size_t targetFaces) : _percentage(-1.0), _maxError(maxError), _targetFaces(targetFaces) {}
+
+	/**
+	 * triangle budget per screen-space error; the error in pixels is converted to object space for the given view
+	 * @param pixelError tolerated deviation in pixels
+	 * @param distance distance between the camera and the model
+	 * @param fov vertical field of view in degrees
+	 * @param viewportHeight viewport height in pixels
+	 * @param targetFaces triangle budget (0 - no budget)
+	 * @return simplify target
+	 */
+	static inline SimplifyTarget screenSpace(GLfloat pixelError, GLfloat distance, GLfloat fov, GLfloat viewportHeight, size_t targetFaces = 0)
+	{
+		GLfloat error = pixelError / screenPixelsPerUnit(distance, fov, viewportHeight);
+
+		return SimplifyTarget(error * error, targetFaces);
+	}
+
+	/**
+	 * switches to the vertex clustering algorithm
+	 * @param gridResolution cells along the longest bounding box axis (0 - derived from the other criteria)
+	 * @return reference to this object
+	 */
+	inline SimplifyTarget& clustering(GLuint gridResolution = 0)
+	{
+		_mode = CLUSTERING;
+		_gridResolution = gridResolution;
+		return *this;
+	}
+
+	/**
+	 * approximate number of output vertices implied by the vertex ratio or the triangle count
+	 * @param inputVertices number of vertices before simplification
+	 * @return number of vertices (0 - neither criterion is enabled)
+	 */
+	inline size_t targetVertices(size_t inputVertices) const
+	{
+		size_t vertices = 0;
+		if (_percentage >= 0.0)
+			vertices = std::max<size_t>(1, static_cast<size_t>(_percentage * inputVertices));
+		if (_targetFaces > 0)
+			vertices = vertices > 0 ? std::min(vertices, _targetFaces / 2 + 1) : _targetFaces / 2 + 1;	//Euler: F ~ 2V
+		return vertices;
+	}
+
+	/**
+	 * checks if vertex ratio criterion is met
+	 * @param vertices current number of vertices
+	 * @param inputVertices number of vertices before simplification
+	 * @return boolean value
+	 */
+	inline bool verticesReached(size_t vertices, size_t inputVertices) const
+	{
+		if (_percentage < 0.0)
+			return false;
+		if (_percentage == 0.0)
+			return vertices <= 1;
+		return vertices <= static_cast<size_t>(_percentage * inputVertices);
+	}
+
+	/**
+	 * checks if any of the criteria is met; called with the cost of the cheapest pair (top of the queue)
+	 * @param vertices current number of vertices
+	 * @param inputVertices number of vertices before simplification
+	 * @param faces current number of faces
+	 * @param cost cost of the next collapse
+	 * @return boolean value
+	 */
+	inline bool reached(size_t vertices, size_t inputVertices, size_t faces, GLfloat cost) const
+	{
+		return
+			verticesReached(vertices, inputVertices) ||
+			(_targetFaces > 0 && faces <= _targetFaces) ||
+			(_maxError >= 0.f && cost > _maxError);
+	}
+};
\ No newline at end of file
@@ -0,0 +1,219 @@
+#pragma once
+
+#include "libs.h"
+
+#include "arena.h"
+
+/**
+ * sorted set of trivially copyable unique values with inline capacity; rings of valence up to N need no heap memory, bigger ones take chunks of the topology pool
+ */
+template <typename T, size_t N>
+class SmallSet
+{
+	union
+	{
+		T _inline[N];	/**< inline storage*/
+		T* _heap;	/**< heap storage, used when values do not fit inline*/
+	};
+	GLuint _size = 0;	/**< number of values*/
+	GLuint _capacity = N;	/**< capacity of current storage (N - inline)*/
+
+	/**
+	 * current storage
+	 * @return pointer to the first value
+	 */
+	inline T* data() { return _capacity == N ? _inline : _heap; }
+	/**
+	 * current storage
+	 * @return pointer to the first value
+	 */
+	inline const T* data() const { return _capacity == N ? _inline : _heap; }
+
+	/**
+	 * makes room for given number of values
+	 * @param capacity requested capacity
+	 */
+	void grow(GLuint capacity)
+	{
+		if (capacity <= _capacity)
+			return;
+
+		capacity = std::max(capacity, 2 * _capacity);
+		T* heap = static_cast<T*>(topologyPool().allocate(capacity * sizeof(T)));
+		std::copy(data(), data() + _size, heap);
+		release();
+		_heap = heap;
+		_capacity = capacity;
+	}
+	/**
+	 * returns heap storage to the pool and switches back to inline storage
+	 */
+	inline void release()
+	{
+		if (_capacity != N)
+			topologyPool().deallocate(_heap, _capacity * sizeof(T));
+		_capacity = N;
+	}
+	/**
+	 * takes values of another set, steals its heap storage
+	 * @param s reference to another SmallSet object
+	 */
+	inline void take(SmallSet& s)
+	{
+		release();
+		if (s._capacity == N)
+			std::copy(s._inline, s._inline + s._size, _inline);
+		else
+		{
+			_heap = s._heap;
+			_capacity = s._capacity;
+			s._capacity = N;
+		}
+		_size = s._size;
+		s._size = 0;
+	}
+
+public:
+
+	/**
+	 * default constructor
+	 */
+	inline SmallSet() {}
+	/**
+	 * copy constructor
+	 * @param s reference to another SmallSet object
+	 */
+	inline SmallSet(const SmallSet& s)
+	{
+		grow(s._size);
+		std::copy(s.data(), s.data() + s._size, data());
+		_size = s._size;
+	}
+	/**
+	 * move constructor
+	 * @param s reference to another SmallSet object
+	 */
+	inline SmallSet(SmallSet&& s)
+	{
+		take(s);
+	}
+	/**
+	 * destructor
+	 */
+	inline ~SmallSet()
+	{
+		release();
+	}
+
+	/**
+	 * copy assignment
+	 * @param s reference to another SmallSet object
+	 * @return reference to this object
+	 */
+	inline SmallSet& operator=(const SmallSet& s)
+	{
+		if (this != &s)
+		{
+			grow(s._size);
+			std::copy(s.data(), s.data() + s._size, data());
+			_size = s._size;
+		}
+		return *this;
+	}
+	/**
+	 * move assignment
+	 * @param s reference to another SmallSet object
+	 * @return reference to this object
+	 */
+	inline SmallSet& operator=(SmallSet&& s)
+	{
+		if (this != &s)
+			take(s);
+		return *this;
+	}
+
+	/**
+	 * first value iterator
+	 * @return pointer to the smallest value
+	 */
+	inline const T* begin() const { return data(); }
+	/**
+	 * end iterator
+	 * @return pointer past the largest value
+	 */
+	inline const T* end() const { return data() + _size; }
+	/**
+	 * size getter
+	 * @return number of values
+	 */
+	inline size_t size() const { return _size; }
+	/**
+	 * checks if the set is empty
+	 * @return boolean value
+	 */
+	inline bool empty() const { return _size == 0; }
+	/**
+	 * removes all values (keeps the storage)
+	 */
+	inline void clear() { _size = 0; }
+
+	/**
+	 * checks if value is in the set
+	 * @param value value to find
+	 * @return 1 if found, 0 otherwise
+	 */
+	inline size_t count(const T& value) const
+	{
+		const T* it = std::lower_bound(begin(), end(), value);
+		return it != end() && *it == value;
+	}
+
+	/**
+	 * inserts value keeping the order, does nothing if value is already in the set
+	 * @param value value to insert
+	 */
+	inline void insert(const T& value)
+	{
+		T* it = std::lower_bound(data(), data() + _size, value);
+		if (it != data() + _size && *it == value)
+			return;
+
+		size_t position = it - data();
+		grow(_size + 1);
+		std::copy_backward(data() + position, data() + _size, data() + _size + 1);
+		data()[position] = value;
+		++_size;
+	}
+
+	/**
+	 * erases value if it is in the set
+	 * @param value value to erase
+	 */
+	inline void erase(const T& value)
+	{
+		T* it = std::lower_bound(data(), data() + _size, value);
+		if (it == data() + _size || *it != value)
+			return;
+
+		std::copy(it + 1, data() + _size, it);
+		--_size;
+
+		//rings shrink back after collapses, their heap chunks are returned as soon as values fit inline
+		if (_capacity != N && _size <= N)
+		{
+			T* heap = _heap;
+			std::copy(heap, heap + _size, _inline);
+			topologyPool().deallocate(heap, _capacity * sizeof(T));
+			_capacity = N;
+		}
+	}
+
+	/**
+	 * heap memory used by the set (0 while values fit inline)
+	 * @return number of bytes
+	 */
+	inline size_t heapBytes() const
+	{
+		return _capacity == N ? 0 : _capacity * sizeof(T);
+	}
+};
\ No newline at end of file
@@ -0,0 +1,73 @@
+#pragma once
+
+#include "libs.h"
+
+const GLuint STREAM_BUFFER_REGIONS = 3;	/**< regions of a stream buffer, the CPU writes one while the GPU may still read the other ones*/
+const GLuint64 STREAM_BUFFER_WAIT = 1000000000;	/**< longest wait for the GPU to release a region in nanoseconds*/
+
+/**
+ * persistently mapped buffer for data re-uploaded every frame; the storage is split into regions used round-robin, every region is guarded by a fence placed after the draw reading it, so uploads neither reallocate nor stall the pipeline
+ */
+class StreamBuffer
+{
+	GLuint _buffer = 0;	/**< buffer object ID*/
+	uint8_t* _mapped = nullptr;	/**< pointer to the whole mapped storage*/
+	size_t _regionSize = 0;	/**< capacity of one region in bytes*/
+	GLuint _region = 0;	/**< region written last*/
+	std::array<GLsync, STREAM_BUFFER_REGIONS> _fences = {};	/**< fences of draws reading regions*/
+
+	/**
+	 * waits until the GPU stops reading region
+	 * @param region region index
+	 */
+	void wait(GLuint region);
+	/**
+	 * (re)creates the storage
+	 * @param regionSize capacity of one region in bytes
+	 */
+	void allocate(size_t regionSize);
+
+public:
+
+	/**
+	 * stream buffer constructor, storage is created by the first write
+	 */
+	StreamBuffer() = default;
+	StreamBuffer(const StreamBuffer&) = delete;
+	StreamBuffer& operator=(const StreamBuffer&) = delete;
+	/**
+	 * stream buffer destructor
+	 */
+	inline ~StreamBuffer() { release(); }
+
+	/**
+	 * moves to the next region and returns it for writing; the storage grows only if bytes do not fit into a region
+	 * @param bytes size of data to write
+	 * @return pointer to the region (coherent, visible to the GPU without a flush)
+	 */
+	void* map(size_t bytes);
+	/**
+	 * guards the region written last, call after the draws reading it are issued
+	 */
+	void fence();
+	/**
+	 * deletes the storage and fences
+	 */
+	void release();
+
+	/**
+	 * buffer object ID
+	 * @return ID
+	 */
+	inline GLuint buffer() const { return _buffer; }
+	/**
+	 * offset of the region written last in bytes
+	 * @return offset
+	 */
+	inline size_t offset() const { return _region * _regionSize; }
+	/**
+	 * size of the storage in bytes
+	 * @return bytes
+	 */
+	inline size_t bytes() const { return _regionSize * STREAM_BUFFER_REGIONS; }
+};
\ No newline at end of file
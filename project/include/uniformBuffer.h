@@ -0,0 +1,65 @@
+#pragma once
+
+#include "libs.h"
+
+const GLuint FRAME_UNIFORMS_BINDING = 0;	/**< binding point of the Frame block*/
+const GLuint MATERIAL_UNIFORMS_BINDING = 1;	/**< binding point of the Material block*/
+
+/**
+ * data of the Frame block, uploaded once per frame (std140 pads vec3 to 16 bytes, so vectors are stored as vec4)
+ */
+struct FrameUniforms
+{
+	glm::mat4 _view;	/**< view matrix*/
+	glm::mat4 _projection;	/**< projection matrix*/
+	glm::vec4 _cameraPosition;	/**< camera position (xyz)*/
+	glm::vec4 _lightPosition;	/**< light position (xyz)*/
+};
+
+/**
+ * data of the Material block, uploaded when the material is created
+ */
+struct MaterialUniforms
+{
+	glm::vec4 _ambient;	/**< ambient light strength (xyz)*/
+	glm::vec4 _diffuse;	/**< diffuse light strength (xyz)*/
+	glm::vec4 _specular;	/**< specular light strength (xyz)*/
+};
+
+/**
+ * uniform buffer object holding one uniform block; all programs read it through its binding point, so it replaces per-program uniform calls
+ */
+template <typename T>
+class UniformBuffer
+{
+	GLuint _buffer = 0;	/**< buffer object ID*/
+	GLuint _binding;	/**< binding point of the block*/
+
+public:
+
+	/**
+	 * creates the buffer
+	 * @param binding binding point of the block (layout binding in GLSL)
+	 */
+	inline UniformBuffer(GLuint binding) : _binding(binding)
+	{
+		glCreateBuffers(1, &_buffer);
+		glNamedBufferStorage(_buffer, sizeof(T), nullptr, GL_DYNAMIC_STORAGE_BIT);
+	}
+	UniformBuffer(const UniformBuffer&) = delete;
+	UniformBuffer& operator=(const UniformBuffer&) = delete;
+	/**
+	 * destructor
+	 */
+	inline ~UniformBuffer() { glDeleteBuffers(1, &_buffer); }
+
+	/**
+	 * uploads the block
+	 * @param data block data
+	 */
+	inline void update(const T& data) { glNamedBufferSubData(_buffer, 0, sizeof(T), &data); }
+	/**
+	 * binds the buffer to its binding point
+	 */
+	inline void bind() const { glBindBufferBase(GL_UNIFORM_BUFFER, _binding, _buffer); }
+};
\ No newline at end of file
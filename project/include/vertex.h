@@ -1,39 +1,99 @@
-#pragma once
-
-#include "libs.h"
-
-/**
- * vertex class for original model
- */
-struct Vertex
-{
-	glm::vec3 _position;
-	glm::vec3 _color;
-	glm::vec2 _texcoord;
-	glm::vec3 _normal;
-};
-
-/**
- * simple vertex for remeshing, containing only position information from the original file
- */
-struct SimpleVertex
-{
-	GLuint _id;
-	glm::vec3 _position;
-
-	glm::mat4 _quad = glm::mat4(.0f); /**< quadric matrix used for QEM remeshing*/
-
-	std::set<GLuint> _neighbors;
-	std::set<GLuint> _faces;
-
-	/**
-	* default constructor
-	*/
-	inline SimpleVertex() {}
-	/**
-	 * constructor
-	 * @param id new vertex ID
-	 * @param position new vertex position
-	 */
-	inline SimpleVertex(GLuint id, glm::vec3 position) : _id(id), _position(position) {}
+#pragma once
+
+#include "libs.h"
+
+#include "smallSet.h"
+
+/**
+ * vertex class for original model
+ */
+struct Vertex
+{
+	glm::vec3 _position;
+	glm::vec3 _color;
+	glm::vec2 _texcoord;
+	glm::vec3 _normal;
+};
+
+/**
+ * quadric of vertex attributes (normal, texcoord, color); its error is the squared deviation of the accumulated attributes from their mean
+ */
+struct AttributeQuadric
+{
+	std::array<GLfloat, 8> _sum = { {.0f, .0f, .0f, .0f, .0f, .0f, .0f, .0f} };	/**< sum of attribute vectors*/
+	GLfloat _squaredSum = .0f;	/**< sum of squared lengths of attribute vectors*/
+	GLfloat _weight = .0f;	/**< number of accumulated attribute vectors*/
+
+	/**
+	 * accumulates attributes of a vertex
+	 * @param v reference to Vertex object
+	 */
+	inline void add(const Vertex& v)
+	{
+		const GLfloat a[8] = { v._normal.x, v._normal.y, v._normal.z, v._texcoord.x, v._texcoord.y, v._color.x, v._color.y, v._color.z };
+		for (size_t i = 0; i < 8; ++i)
+		{
+			_sum[i] += a[i];
+			_squaredSum += a[i] * a[i];
+		}
+		_weight += 1.f;
+	}
+
+	/**
+	 * sum of two quadrics
+	 * @param q reference to another AttributeQuadric object
+	 * @return sum
+	 */
+	inline AttributeQuadric operator+(const AttributeQuadric& q) const
+	{
+		AttributeQuadric r;
+		for (size_t i = 0; i < 8; ++i)
+			r._sum[i] = _sum[i] + q._sum[i];
+		r._squaredSum = _squaredSum + q._squaredSum;
+		r._weight = _weight + q._weight;
+		return r;
+	}
+
+	/**
+	 * error of replacing all accumulated attributes with their mean
+	 * @return error
+	 */
+	inline GLfloat error() const
+	{
+		if (_weight == .0f)
+			return .0f;
+
+		GLfloat sumSquared = .0f;
+		for (size_t i = 0; i < 8; ++i)
+			sumSquared += _sum[i] * _sum[i];
+		return std::max(_squaredSum - sumSquared / _weight, .0f);
+	}
+};
+
+/**
+ * simple vertex for remeshing, containing only position information from the original file
+ */
+struct SimpleVertex
+{
+	GLuint _id;
+	glm::vec3 _position;
+
+	glm::mat4 _quad = glm::mat4(.0f); /**< quadric matrix used for QEM remeshing*/
+	AttributeQuadric _attributeQuad;	/**< attribute quadric used for attribute-aware QEM*/
+
+	SmallSet<GLuint, 8> _neighbors;	/**< IDs of neighboring vertices (one-ring)*/
+	SmallSet<GLuint, 8> _faces;	/**< IDs of incident faces*/
+
+	GLfloat _size = .0f;	/**< target edge length at the vertex (sizing field of the remeshing)*/
+
+	/**
+	* default constructor
+	*/
+	inline SimpleVertex() {}
+	/**
+	 * constructor
+	 * @param id new vertex ID
+	 * @param position new vertex position
+	 */
+	inline SimpleVertex(GLuint id, glm::vec3 position) : _id(id), _position(position) {}
 };
\ No newline at end of file
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "libs.h"
+
+const size_t VERTEX_CACHE_SIZE = 32;	/**< LRU cache size modelled by the optimizer (Forsyth)*/
+const size_t VERTEX_CACHE_SIMULATED = 16;	/**< FIFO post-transform cache size used to measure index orders*/
+
+/**
+ * vertex cache efficiency of an index order, measured on a simulated FIFO post-transform cache
+ */
+struct VertexCacheStats
+{
+	GLfloat _acmr = .0f;	/**< average cache miss ratio, transformed vertices per triangle (0.5 - ideal for large meshes, 3 - no reuse)*/
+	GLfloat _atvr = .0f;	/**< average transform to vertex ratio, transformed vertices per referenced vertex (1 - ideal)*/
+};
+
+/**
+ * simulates a FIFO vertex cache
+ * @param indices triangle list
+ * @param vertexCount number of vertices (indices have to be lower)
+ * @param cacheSize number of cache entries
+ * @return statistics
+ */
+VertexCacheStats simulateVertexCache(const std::vector<GLuint>& indices, size_t vertexCount, size_t cacheSize = VERTEX_CACHE_SIMULATED);
+
+/**
+ * reorders triangles for the post-transform vertex cache (Tom Forsyth, Linear-Speed Vertex Cache Optimisation); triangles are emitted greedily by scores of their vertices, which prefer recently used vertices and vertices with few remaining triangles
+ * @param indices triangle list, reordered in place
+ * @param vertexCount number of vertices (indices have to be lower)
+ */
+void optimizeVertexCache(std::vector<GLuint>& indices, size_t vertexCount);
+
+/**
+ * renumbers vertices in order of their first use, so the vertex buffer is read sequentially
+ * @param indices triangle list, renumbered in place
+ * @param vertexCount number of vertices (indices have to be lower)
+ * @return new index of every old vertex (unreferenced vertices are moved to the end)
+ */
+std::vector<GLuint> optimizeVertexFetch(std::vector<GLuint>& indices, size_t vertexCount);
\ No newline at end of file
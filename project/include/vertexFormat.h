@@ -0,0 +1,98 @@
+#pragma once
+
+#include "libs.h"
+
+#include "vertex.h"
+
+/**
+ * attribute of a packed vertex, arguments of glVertexAttribPointer
+ */
+struct VertexAttribute
+{
+	GLuint _location;	/**< shader input location*/
+	GLint _size;	/**< number of components*/
+	GLenum _type;	/**< type of components*/
+	GLboolean _normalized;	/**< integer components are mapped to [0, 1] or [-1, 1]*/
+	size_t _offset;	/**< offset from the start of the vertex in bytes*/
+};
+
+/**
+ * maps quantized attributes back in the vertex shader
+ */
+struct VertexDequantization
+{
+	glm::vec3 _positionOffset = glm::vec3(.0f);	/**< object space position of the normalized position 0 (bounding box minimum)*/
+	glm::vec3 _positionScale = glm::vec3(1.f);	/**< object space size of the normalized position 1 (bounding box size)*/
+	bool _octahedralNormals = false;	/**< normals are 2 octahedral components*/
+};
+
+/**
+ * largest differences between quantized attributes decoded as the shader does and the original ones
+ */
+struct QuantizationError
+{
+	GLfloat _position = .0f;	/**< position distance in object space*/
+	GLfloat _positionRelative = .0f;	/**< position distance relative to the bounding box diagonal*/
+	GLfloat _normal = .0f;	/**< normal angle in degrees*/
+	GLfloat _texcoord = .0f;	/**< texcoord component difference*/
+	GLfloat _color = .0f;	/**< color component difference*/
+};
+
+/**
+ * render-export of vertices; only attributes read by the shader are written, interleaved without padding
+ */
+struct PackedVertices
+{
+	std::vector<uint8_t> _data;	/**< interleaved vertex data*/
+	GLsizei _stride = 0;	/**< size of one vertex in bytes*/
+	std::vector<VertexAttribute> _attributes;	/**< attributes within a vertex*/
+	VertexDequantization _dequantization;	/**< shader parameters decoding the attributes*/
+	QuantizationError _error;	/**< quality loss of quantized attributes*/
+
+	/**
+	 * number of vertices
+	 * @return number of vertices
+	 */
+	inline size_t size() const { return _stride > 0 ? _data.size() / _stride : 0; }
+	/**
+	 * size of data in bytes
+	 * @return bytes
+	 */
+	inline size_t bytes() const { return _data.size(); }
+
+	/**
+	 * positions only (location 0), used by wireframe meshes
+	 * @param vertices vector of simple vertices
+	 * @return packed vertices
+	 */
+	static PackedVertices positions(const std::vector<SimpleVertex>& vertices);
+	/**
+	 * positions only (location 0), used by wireframe meshes
+	 * @param vertices vector of vertices
+	 * @return packed vertices
+	 */
+	static PackedVertices positions(const std::vector<Vertex>& vertices);
+	/**
+	 * all attributes (position, color, texcoord, normal at locations 0 - 3)
+	 * @param vertices vector of vertices
+	 * @param quantize store positions as 16-bit integers within the bounding box, colors as 8-bit integers, texcoords as half floats and normals as 16-bit octahedral components (20 instead of 44 bytes per vertex)
+	 * @return packed vertices
+	 */
+	static PackedVertices attributes(const std::vector<Vertex>& vertices, bool quantize);
+
+	/**
+	 * moves vertices to new positions
+	 * @param remap new position of every vertex
+	 */
+	void reorder(const std::vector<GLuint>& remap);
+	/**
+	 * sets and enables attribute pointers of the bound VAO and VBO
+	 */
+	void setAttributePointers() const;
+	/**
+	 * sets and enables attribute formats of vertex array object read from one vertex buffer binding
+	 * @param vao vertex array object ID
+	 * @param binding vertex buffer binding index
+	 */
+	void setAttributeFormats(GLuint vao, GLuint binding) const;
+};
\ No newline at end of file
@@ -0,0 +1,129 @@
+#pragma once
+
+#include "libs.h"
+
+#include "vertex.h"
+#include "face.h"
+#include "adjacency.h"
+#include "edgeCost.h"
+#include "parallel.h"
+
+/**
+ * structure-of-arrays copy of simple vertices, indexed by dense slot (position in the vertex vector); gathered for passes which read the same arrays many times (relaxation, smoothing of the sizing field) and for small re-costing batches
+ */
+struct VertexStreams
+{
+	std::vector<GLuint> _ids;	/**< vertex ID of every slot (sorted when gathered from all vertices)*/
+	std::vector<GLfloat> _x;	/**< x coordinates*/
+	std::vector<GLfloat> _y;	/**< y coordinates*/
+	std::vector<GLfloat> _z;	/**< z coordinates*/
+	std::vector<GLfloat> _sizes;	/**< target edge lengths of the remeshing*/
+	std::array<std::vector<GLfloat>, 10> _quad;	/**< upper triangle of symmetric quadrics, row by row (a00 a01 a02 a03 a11 a12 a13 a22 a23 a33)*/
+	std::vector<AttributeQuadric> _attributeQuad;	/**< attribute quadrics*/
+	Adjacency _neighbors;	/**< neighbor slots of every slot*/
+
+	std::array<std::vector<GLuint>, 2> _edges;	/**< slots of both vertices of every edge*/
+	std::vector<std::array<GLuint, 3>> _triangles;	/**< slots of corners of every face*/
+	Adjacency _vertexFaces;	/**< positions of faces (in _triangles) of every slot*/
+	std::vector<glm::vec3> _faceNormals;	/**< area-weighted normals of faces, computed by computeFaceNormals*/
+
+	std::vector<GLfloat> _relaxedX;	/**< second position buffer written by relax*/
+	std::vector<GLfloat> _relaxedY;	/**< second position buffer written by relax*/
+	std::vector<GLfloat> _relaxedZ;	/**< second position buffer written by relax*/
+
+	/**
+	 * number of slots
+	 * @return number of vertices
+	 */
+	inline size_t size() const { return _ids.size(); }
+	/**
+	 * slot of vertex
+	 * @param id vertex ID
+	 * @return slot
+	 */
+	inline GLuint slot(GLuint id) const { return std::lower_bound(_ids.begin(), _ids.end(), id) - _ids.begin(); }
+
+	/**
+	 * copies IDs, positions and target edge lengths of vertices
+	 * @param vertices vector of vertices sorted by ID
+	 */
+	void gatherPositions(const std::vector<SimpleVertex>& vertices);
+	/**
+	 * converts neighbor rings to slots (call gatherPositions first)
+	 * @param vertices vector of vertices sorted by ID
+	 */
+	void gatherNeighbors(const std::vector<SimpleVertex>& vertices);
+	/**
+	 * converts faces to slots, and rings of faces of vertices to face positions (call gatherPositions first)
+	 * @param vertices vector of vertices sorted by ID
+	 * @param faces vector of faces sorted by ID
+	 */
+	void gatherFaces(const std::vector<SimpleVertex>& vertices, const std::vector<Face>& faces);
+	/**
+	 * removes all slots and edges (keeps the storage)
+	 */
+	void clear();
+	/**
+	 * appends one vertex with its position and quadrics, used for small batches (e.g. the ring of a collapsed vertex)
+	 * @param vertex reference to vertex
+	 * @param attributes copy attribute quadric as well
+	 * @return slot of vertex
+	 */
+	GLuint push(const SimpleVertex& vertex, bool attributes);
+	/**
+	 * appends an edge
+	 * @param a slot of first vertex
+	 * @param b slot of second vertex
+	 */
+	inline void pushEdge(GLuint a, GLuint b)
+	{
+		_edges[0].push_back(a);
+		_edges[1].push_back(b);
+	}
+	/**
+	 * writes positions back to vertices
+	 * @param vertices vector of vertices the streams were gathered from
+	 */
+	void scatterPositions(std::vector<SimpleVertex>& vertices) const;
+	/**
+	 * writes target edge lengths back to vertices
+	 * @param vertices vector of vertices the streams were gathered from
+	 */
+	void scatterSizes(std::vector<SimpleVertex>& vertices) const;
+
+	/**
+	 * computes area-weighted normals of gathered faces
+	 */
+	void computeFaceNormals();
+	/**
+	 * sum of normals of faces around slot; faces keep their vertices sorted, not wound, so normals are aligned to the first one (call computeFaceNormals first)
+	 * @param i slot
+	 * @return normal (not normalized, zero if there are no faces)
+	 */
+	inline glm::vec3 vertexNormal(size_t i) const
+	{
+		glm::vec3 normal(.0f);
+		for (const GLuint* f = _vertexFaces.begin(i); f != _vertexFaces.end(i); ++f)
+			normal += glm::dot(_faceNormals[*f], normal) < .0f ? -_faceNormals[*f] : _faceNormals[*f];
+		return normal;
+	}
+	/**
+	 * fills target edge lengths from the largest normal curvature at every vertex, so chords deviate from the surface by at most error; curvatures are estimated in parallel, then the lengths are clamped and smoothed
+	 * @param error tolerated distance between edges and the surface
+	 * @param minSize shortest target edge length
+	 * @param maxSize longest target edge length
+	 * @param smoothing averaging iterations with neighbors
+	 */
+	void sizingField(GLfloat error, GLfloat minSize, GLfloat maxSize, GLuint smoothing);
+	/**
+	 * moves every vertex towards the average position of its neighbors; all vertices read the old positions and write the second buffer, so vertices are processed in parallel
+	 * @param tangential move only within the tangent plane (vertex normal from gathered faces), boundary vertices stay in place
+	 */
+	void relax(bool tangential);
+	/**
+	 * cost of collapsing every edge to its midpoint, v^T * (Q1 + Q2) * v (SIMD edge cost kernel) plus scaled attribute error
+	 * @param attributeScale scale of attribute error (0 - geometry only)
+	 * @param costs output vector, one cost per edge
+	 */
+	void edgeCosts(GLfloat attributeScale, std::vector<GLfloat>& costs) const;
+};
\ No newline at end of file
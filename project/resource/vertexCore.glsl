@@ -1,25 +1,74 @@
-#version 450
-
-layout (location = 0) in vec3 vertex_position;
-layout (location = 1) in vec3 vertex_color;
-layout (location = 2) in vec2 vertex_texcoord;
-layout (location = 3) in vec3 vertex_normal;
-
-out vec3 vsPosition;
-out vec3 vsColor;
-out vec2 vsTexcoord;
-out vec3 vsNormal;
-
-uniform mat4 ModelMatrix;
-uniform mat4 ViewMatrix;
-uniform mat4 ProjectionMatrix;
-
-void main()
-{
-	vsPosition = vec4(ModelMatrix * vec4(vertex_position, 1.f)).xyz;
-	vsColor = vertex_color;
-	vsTexcoord = vec2(vertex_texcoord.x, vertex_texcoord.y * -1.f);
-	vsNormal = mat3(ModelMatrix) * vertex_normal;
-
-	gl_Position = ProjectionMatrix * ViewMatrix * ModelMatrix * vec4(vertex_position, 1.f);
+#version 450
+
+layout (location = 0) in vec3 vertex_position;
+layout (location = 1) in vec3 vertex_color;
+layout (location = 2) in vec2 vertex_texcoord;
+layout (location = 3) in vec3 vertex_normal;	//octahedral components in xy if OctahedralNormals is set
+layout (location = 4) in uint instance_index;	//batched draws only
+
+out vec3 vsPosition;
+out vec3 vsColor;
+out vec2 vsTexcoord;
+out vec3 vsNormal;
+
+uniform mat4 ModelMatrix;
+
+//per-frame data, shared with the fragment shader
+layout (std140, binding = 0) uniform Frame
+{
+	mat4 ViewMatrix;
+	mat4 ProjectionMatrix;
+	vec3 cameraPos;
+	vec3 lightPos0;
+};
+
+//dequantization (offset 0, scale 1 and float normals for unquantized meshes)
+uniform vec3 PositionOffset;
+uniform vec3 PositionScale;
+uniform bool OctahedralNormals;
+
+//batched draws read the model matrix and dequantization of every instance instead of the uniforms
+struct Instance
+{
+	mat4 modelMatrix;
+	vec4 positionOffset;
+	vec4 positionScale;
+};
+
+layout (std430, binding = 0) readonly buffer Instances
+{
+	Instance instances[];
+};
+
+uniform bool Batched;
+
+vec3 octahedralDecode(vec2 e)
+{
+	vec3 n = vec3(e, 1.f - abs(e.x) - abs(e.y));
+	float t = max(-n.z, 0.f);
+	n.xy += vec2(n.x >= 0.f ? -t : t, n.y >= 0.f ? -t : t);
+	return normalize(n);
+}
+
+void main()
+{
+	mat4 modelMatrix = ModelMatrix;
+	vec3 positionOffset = PositionOffset;
+	vec3 positionScale = PositionScale;
+	if (Batched)
+	{
+		modelMatrix = instances[instance_index].modelMatrix;
+		positionOffset = instances[instance_index].positionOffset.xyz;
+		positionScale = instances[instance_index].positionScale.xyz;
+	}
+
+	vec3 position = positionOffset + positionScale * vertex_position;
+	vec3 normal = OctahedralNormals ? octahedralDecode(vertex_normal.xy) : vertex_normal;
+
+	vsPosition = vec4(modelMatrix * vec4(position, 1.f)).xyz;
+	vsColor = vertex_color;
+	vsTexcoord = vec2(vertex_texcoord.x, vertex_texcoord.y * -1.f);
+	vsNormal = mat3(modelMatrix) * normal;
+
+	gl_Position = ProjectionMatrix * ViewMatrix * modelMatrix * vec4(position, 1.f);
 }
\ No newline at end of file
@@ -0,0 +1,56 @@
+#include "../include/adjacency.h"
+
+void Adjacency::buildFaces(size_t vertexCount, const std::vector<Face>& faces)
+{
+	//count entries, prefix sum, fill (counting sort)
+	_offsets.assign(vertexCount + 1, 0);
+	for (auto& f : faces)
+		for (auto v : f._vertices)
+			++_offsets[v + 1];
+	for (size_t i = 0; i < vertexCount; ++i)
+		_offsets[i + 1] += _offsets[i];
+
+	_indices.resize(_offsets[vertexCount]);
+	std::vector<GLuint> fill(_offsets.begin(), _offsets.end() - 1);
+	for (size_t i = 0; i < faces.size(); ++i)
+		for (auto v : faces[i]._vertices)
+			_indices[fill[v]++] = i;
+}
+
+void Adjacency::buildNeighbors(size_t vertexCount, const std::vector<Face>& faces)
+{
+	//two candidates per corner, duplicates are removed per vertex afterwards
+	std::vector<GLuint> offsets(vertexCount + 1, 0);
+	for (auto& f : faces)
+		for (auto v : f._vertices)
+			offsets[v + 1] += 2;
+	for (size_t i = 0; i < vertexCount; ++i)
+		offsets[i + 1] += offsets[i];
+
+	std::vector<GLuint> candidates(offsets[vertexCount]);
+	std::vector<GLuint> fill(offsets.begin(), offsets.end() - 1);
+	for (auto& f : faces)
+		for (size_t i = 0; i < 3; ++i)
+		{
+			candidates[fill[f._vertices[i]]++] = f._vertices[(i + 1) % 3];
+			candidates[fill[f._vertices[i]]++] = f._vertices[(i + 2) % 3];
+		}
+
+	//sort and deduplicate every vertex' segment in parallel, then compact them
+	_offsets.assign(vertexCount + 1, 0);
+	parallelFor(0, vertexCount, [&](size_t v)
+	{
+		auto first = candidates.begin() + offsets[v];
+		auto last = candidates.begin() + offsets[v + 1];
+		std::sort(first, last);
+		_offsets[v + 1] = std::unique(first, last) - first;
+	});
+	for (size_t v = 0; v < vertexCount; ++v)
+		_offsets[v + 1] += _offsets[v];
+
+	_indices.resize(_offsets[vertexCount]);
+	parallelFor(0, vertexCount, [&](size_t v)
+	{
+		std::copy(candidates.begin() + offsets[v], candidates.begin() + offsets[v] + (_offsets[v + 1] - _offsets[v]), _indices.begin() + _offsets[v]);
+	});
+}
\ No newline at end of file
@@ -0,0 +1,69 @@
+#include "../include/arena.h"
+
+void* Arena::allocate(size_t bytes, size_t alignment)
+{
+	//find a block with enough room, starting with the current one
+	for (; _block < _blocks.size(); ++_block, _offset = 0)
+	{
+		size_t start = (reinterpret_cast<uintptr_t>(_blocks[_block].get()) + _offset + alignment - 1) / alignment * alignment - reinterpret_cast<uintptr_t>(_blocks[_block].get());
+		if (start + bytes <= _sizes[_block])
+		{
+			_offset = start + bytes;
+			return _blocks[_block].get() + start;
+		}
+	}
+
+	//no room left, add a new block (big requests get their own)
+	size_t size = std::max(ARENA_BLOCK_SIZE, bytes + alignment);
+	_blocks.emplace_back(new char[size]);
+	_sizes.push_back(size);
+	_block = _blocks.size() - 1;
+	_offset = 0;
+	return allocate(bytes, alignment);
+}
+
+size_t Pool::sizeClass(size_t bytes)
+{
+	size_t c = 0;
+	while (c < POOL_CLASSES && (size_t(16) << c) < bytes)
+		++c;
+	return c;
+}
+
+void* Pool::allocate(size_t bytes)
+{
+	size_t c = sizeClass(bytes);
+	if (c == POOL_CLASSES)
+		return ::operator new(bytes);
+
+	std::lock_guard<std::mutex> lock(_mutex);
+	if (_free[c])
+	{
+		void* p = _free[c];
+		_free[c] = *static_cast<void**>(p);
+		return p;
+	}
+	return _arena.allocate(size_t(16) << c, alignof(std::max_align_t));
+}
+
+void Pool::deallocate(void* p, size_t bytes)
+{
+	size_t c = sizeClass(bytes);
+	if (c == POOL_CLASSES)
+	{
+		::operator delete(p);
+		return;
+	}
+
+	//freed chunk stores the link to the next free chunk
+	std::lock_guard<std::mutex> lock(_mutex);
+	*static_cast<void**>(p) = _free[c];
+	_free[c] = p;
+}
+
+Pool& topologyPool()
+{
+	//never destroyed, rings of meshes deleted during static destruction may still return their chunks
+	static Pool* pool = new Pool;
+	return *pool;
+}
\ No newline at end of file
@@ -0,0 +1,134 @@
+#include "../include/batchRenderer.h"
+
+BatchRenderer::~BatchRenderer()
+{
+	if (_VAO)
+		glDeleteVertexArrays(1, &_VAO);
+	glDeleteBuffers(1, &_VBO);
+	glDeleteBuffers(1, &_EBO);
+	glDeleteBuffers(1, &_instanceIndices);
+}
+
+GLuint BatchRenderer::addMesh(const Mesh* mesh)
+{
+	std::vector<GLuint> indices;
+	PackedVertices packed = mesh->exportGeometry(false, indices);
+	if (_meshes.empty())
+	{
+		_format = packed;
+		_format._data.clear();
+	}
+
+	BatchMesh batchMesh;
+	batchMesh._firstIndex = static_cast<GLuint>(_indexData.size());
+	batchMesh._count = static_cast<GLuint>(indices.size());
+	batchMesh._baseVertex = static_cast<GLint>(_vertexData.size() / _format._stride);
+	batchMesh._dequantization = packed._dequantization;
+
+	//bounding sphere around the center of the bounding box
+	glm::vec3 minimum(std::numeric_limits<GLfloat>::max());
+	glm::vec3 maximum(-std::numeric_limits<GLfloat>::max());
+	for (auto& v : mesh->_vertices)
+	{
+		minimum = glm::min(minimum, v._position);
+		maximum = glm::max(maximum, v._position);
+	}
+	if (!mesh->_vertices.empty())
+	{
+		batchMesh._center = .5f * (minimum + maximum);
+		for (auto& v : mesh->_vertices)
+			batchMesh._radius = std::max(batchMesh._radius, glm::distance(v._position, batchMesh._center));
+	}
+
+	_vertexData.insert(_vertexData.end(), packed._data.begin(), packed._data.end());
+	_indexData.insert(_indexData.end(), indices.begin(), indices.end());
+	_meshes.push_back(batchMesh);
+	return static_cast<GLuint>(_meshes.size() - 1);
+}
+
+void BatchRenderer::build()
+{
+	glCreateBuffers(1, &_VBO);
+	glNamedBufferStorage(_VBO, std::max(_vertexData.size(), static_cast<size_t>(1)), _vertexData.data(), 0);
+	glCreateBuffers(1, &_EBO);
+	glNamedBufferStorage(_EBO, std::max(_indexData.size() * sizeof(GLuint), sizeof(GLuint)), _indexData.data(), 0);
+
+	glCreateVertexArrays(1, &_VAO);
+	glVertexArrayVertexBuffer(_VAO, 0, _VBO, 0, _format._stride);
+	glVertexArrayElementBuffer(_VAO, _EBO);
+	_format.setAttributeFormats(_VAO, 0);
+
+	//instance index advances once per instance, base instance of a command selects its first instance
+	glEnableVertexArrayAttrib(_VAO, BATCH_INSTANCE_LOCATION);
+	glVertexArrayAttribIFormat(_VAO, BATCH_INSTANCE_LOCATION, 1, GL_UNSIGNED_INT, 0);
+	glVertexArrayAttribBinding(_VAO, BATCH_INSTANCE_LOCATION, 1);
+	glVertexArrayBindingDivisor(_VAO, 1, 1);
+
+	_vertexData = std::vector<uint8_t>();
+	_indexData = std::vector<GLuint>();
+}
+
+void BatchRenderer::render(Shader* shader, GLuint polygonMode)
+{
+	if (!_VAO || _instances.empty())
+		return;
+
+	//group instances by mesh, every mesh becomes one command
+	std::vector<GLuint> counts(_meshes.size() + 1, 0);
+	for (auto& i : _instances)
+		++counts[i.first + 1];
+	for (size_t m = 0; m < _meshes.size(); ++m)
+		counts[m + 1] += counts[m];
+
+	_commands.clear();
+	for (size_t m = 0; m < _meshes.size(); ++m)
+		if (counts[m + 1] > counts[m])
+			_commands.push_back({ _meshes[m]._count, counts[m + 1] - counts[m], _meshes[m]._firstIndex, _meshes[m]._baseVertex, counts[m] });
+
+	_instanceData.resize(_instances.size());
+	for (auto& i : _instances)
+	{
+		const BatchMesh& mesh = _meshes[i.first];
+		_instanceData[counts[i.first]++] = { i.second, glm::vec4(mesh._dequantization._positionOffset, .0f), glm::vec4(mesh._dequantization._positionScale, .0f) };
+	}
+
+	//the instance index buffer only grows
+	GLuint instanceCount = static_cast<GLuint>(_instances.size());
+	if (instanceCount > _instanceCapacity)
+	{
+		_instanceCapacity = std::max(instanceCount, 2 * _instanceCapacity);
+		std::vector<GLuint> iota(_instanceCapacity);
+		for (GLuint i = 0; i < _instanceCapacity; ++i)
+			iota[i] = i;
+		glDeleteBuffers(1, &_instanceIndices);
+		glCreateBuffers(1, &_instanceIndices);
+		glNamedBufferStorage(_instanceIndices, iota.size() * sizeof(GLuint), iota.data(), 0);
+		glVertexArrayVertexBuffer(_VAO, 1, _instanceIndices, 0, sizeof(GLuint));
+	}
+
+	//per-frame data go through the persistently mapped stream buffers
+	size_t instanceBytes = _instanceData.size() * sizeof(BatchInstance);
+	std::memcpy(_instanceStream.map(instanceBytes), _instanceData.data(), instanceBytes);
+	size_t commandBytes = _commands.size() * sizeof(DrawElementsIndirectCommand);
+	std::memcpy(_commandStream.map(commandBytes), _commands.data(), commandBytes);
+
+	shader->set1i(GL_TRUE, "Batched");
+	shader->set1i(_format._dequantization._octahedralNormals, "OctahedralNormals");
+	shader->use();
+
+	glBindVertexArray(_VAO);
+	glBindBufferRange(GL_SHADER_STORAGE_BUFFER, BATCH_INSTANCES_BINDING, _instanceStream.buffer(), _instanceStream.offset(), instanceBytes);
+	glBindBuffer(GL_DRAW_INDIRECT_BUFFER, _commandStream.buffer());
+	glPolygonMode(GL_FRONT_AND_BACK, polygonMode);
+
+	glMultiDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_INT, (GLvoid*)_commandStream.offset(), static_cast<GLsizei>(_commands.size()), 0);
+
+	_instanceStream.fence();
+	_commandStream.fence();
+
+	//cleanup
+	glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+	glBindVertexArray(0);
+	shader->set1i(GL_FALSE, "Batched");
+	glUseProgram(0);
+}
\ No newline at end of file
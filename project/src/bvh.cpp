@@ -0,0 +1,306 @@
+#include "../include/bvh.h"
+
+/**
+ * surface area of box
+ * @param min lower corner
+ * @param max upper corner
+ * @return area (0 for an empty box)
+ */
+static inline GLfloat boxArea(const glm::vec3& min, const glm::vec3& max)
+{
+	glm::vec3 d = glm::max(max - min, glm::vec3(.0f));
+	return 2.f * (d.x * d.y + d.y * d.z + d.z * d.x);
+}
+
+/**
+ * squared distance of point to box
+ * @param p point
+ * @param node node with the box
+ * @return squared distance (0 inside)
+ */
+static inline GLfloat boxDistance2(const glm::vec3& p, const BvhNode& node)
+{
+	glm::vec3 d = glm::max(glm::max(node._min - p, p - node._max), glm::vec3(.0f));
+	return glm::dot(d, d);
+}
+
+/**
+ * triangle count and bounds of triangles whose centroids fall into a bin
+ */
+struct BvhBin
+{
+	glm::vec3 _min = glm::vec3(std::numeric_limits<GLfloat>::max());	/**< lower corner of bounds*/
+	glm::vec3 _max = glm::vec3(-std::numeric_limits<GLfloat>::max());	/**< upper corner of bounds*/
+	size_t _count = 0;	/**< number of triangles*/
+
+	/**
+	 * adds a box
+	 * @param min lower corner
+	 * @param max upper corner
+	 */
+	inline void add(const glm::vec3& min, const glm::vec3& max)
+	{
+		_min = glm::min(_min, min);
+		_max = glm::max(_max, max);
+	}
+	/**
+	 * adds another bin
+	 * @param bin reference to bin
+	 */
+	inline void add(const BvhBin& bin)
+	{
+		add(bin._min, bin._max);
+		_count += bin._count;
+	}
+};
+
+void Bvh::build(const std::vector<glm::vec3>& positions, const std::vector<std::array<GLuint, 3>>& triangles)
+{
+	size_t n = triangles.size();
+	_nodes.clear();
+	_triangles.clear();
+	_ids.clear();
+	if (n == 0)
+		return;
+
+	std::vector<std::array<glm::vec3, 2>> bounds(n);
+	std::vector<glm::vec3> centroids(n);
+	std::vector<GLuint> order(n);
+	parallelFor(0, n, [&](size_t i)
+	{
+		const glm::vec3& a = positions[triangles[i][0]];
+		const glm::vec3& b = positions[triangles[i][1]];
+		const glm::vec3& c = positions[triangles[i][2]];
+		bounds[i][0] = glm::min(a, glm::min(b, c));
+		bounds[i][1] = glm::max(a, glm::max(b, c));
+		centroids[i] = (bounds[i][0] + bounds[i][1]) * .5f;
+		order[i] = static_cast<GLuint>(i);
+	});
+
+	//a binary tree with leaves of at least one triangle has at most 2n - 1 nodes
+	_nodes.resize(2 * n - 1);
+	std::atomic<GLuint> nodeCount(1);
+	buildNode(0, 0, n, 0, order, bounds, centroids, nodeCount);
+	_nodes.resize(nodeCount);
+
+	//triangles are stored in leaf order, so leaves read contiguous memory
+	_triangles.resize(n);
+	_ids.resize(n);
+	parallelFor(0, n, [&](size_t i)
+	{
+		const std::array<GLuint, 3>& t = triangles[order[i]];
+		_triangles[i] = { { positions[t[0]], positions[t[1]], positions[t[2]] } };
+		_ids[i] = order[i];
+	});
+}
+
+void Bvh::buildNode
+(
+	GLuint node,
+	size_t begin,
+	size_t end,
+	size_t depth,
+	std::vector<GLuint>& order,
+	const std::vector<std::array<glm::vec3, 2>>& bounds,
+	const std::vector<glm::vec3>& centroids,
+	std::atomic<GLuint>& nodeCount
+)
+{
+	size_t count = end - begin;
+
+	//bounds of triangles and of their centroids
+	BvhBin box;
+	glm::vec3 centroidMin(std::numeric_limits<GLfloat>::max());
+	glm::vec3 centroidMax(-std::numeric_limits<GLfloat>::max());
+	for (size_t i = begin; i < end; ++i)
+	{
+		box.add(bounds[order[i]][0], bounds[order[i]][1]);
+		centroidMin = glm::min(centroidMin, centroids[order[i]]);
+		centroidMax = glm::max(centroidMax, centroids[order[i]]);
+	}
+	_nodes[node]._min = box._min;
+	_nodes[node]._max = box._max;
+
+	glm::vec3 extent = centroidMax - centroidMin;
+	if (count <= BVH_LEAF_SIZE || depth >= BVH_MAX_DEPTH || std::max(extent.x, std::max(extent.y, extent.z)) <= .0f)
+	{
+		_nodes[node]._first = static_cast<GLuint>(begin);
+		_nodes[node]._count = static_cast<GLuint>(count);
+		return;
+	}
+
+	//bin centroids along every axis; the root is binned by all threads, lower nodes already run in parallel
+	auto binOf = [&](size_t axis, GLuint t)
+	{
+		size_t bin = static_cast<size_t>(BVH_BINS * (centroids[t][axis] - centroidMin[axis]) / extent[axis]);
+		return std::min(bin, BVH_BINS - 1);
+	};
+	std::array<std::array<BvhBin, BVH_BINS>, 3> bins;
+	auto fillBins = [&](size_t chunkBegin, size_t chunkEnd, std::array<std::array<BvhBin, BVH_BINS>, 3>& out)
+	{
+		for (size_t i = chunkBegin; i < chunkEnd; ++i)
+		{
+			GLuint t = order[i];
+			for (size_t axis = 0; axis < 3; ++axis)
+			{
+				if (extent[axis] <= .0f)
+					continue;
+				BvhBin& bin = out[axis][binOf(axis, t)];
+				bin.add(bounds[t][0], bounds[t][1]);
+				++bin._count;
+			}
+		}
+	};
+	if (depth == 0 && count >= BVH_PARALLEL_SIZE)
+	{
+		std::vector<std::array<std::array<BvhBin, BVH_BINS>, 3>> local(parallelThreads(count));
+		parallelChunks(begin, end, [&](size_t chunkBegin, size_t chunkEnd, size_t thread) { fillBins(chunkBegin, chunkEnd, local[thread]); });
+		for (auto& l : local)
+			for (size_t axis = 0; axis < 3; ++axis)
+				for (size_t b = 0; b < BVH_BINS; ++b)
+					bins[axis][b].add(l[axis][b]);
+	}
+	else
+		fillBins(begin, end, bins);
+
+	//SAH: cost of a split relative to intersecting all triangles of the node
+	GLfloat bestCost = std::numeric_limits<GLfloat>::max();
+	size_t bestAxis = 0;
+	size_t bestSplit = 0;
+	GLfloat area = boxArea(box._min, box._max);
+	for (size_t axis = 0; axis < 3; ++axis)
+	{
+		if (extent[axis] <= .0f)
+			continue;
+
+		//areas and counts of all bins right of every plane
+		std::array<GLfloat, BVH_BINS> rightArea;
+		std::array<size_t, BVH_BINS> rightCount;
+		BvhBin right;
+		for (size_t b = BVH_BINS - 1; b > 0; --b)
+		{
+			right.add(bins[axis][b]);
+			rightArea[b] = boxArea(right._min, right._max);
+			rightCount[b] = right._count;
+		}
+
+		BvhBin left;
+		for (size_t b = 1; b < BVH_BINS; ++b)
+		{
+			left.add(bins[axis][b - 1]);
+			if (left._count == 0 || rightCount[b] == 0)
+				continue;
+			GLfloat cost = 1.f + (left._count * boxArea(left._min, left._max) + rightCount[b] * rightArea[b]) / std::max(area, FLT_MIN);
+			if (cost < bestCost)
+			{
+				bestCost = cost;
+				bestAxis = axis;
+				bestSplit = b;
+			}
+		}
+	}
+
+	if (bestCost >= count && count <= BVH_MAX_LEAF_SIZE)
+	{
+		_nodes[node]._first = static_cast<GLuint>(begin);
+		_nodes[node]._count = static_cast<GLuint>(count);
+		return;
+	}
+
+	size_t middle;
+	if (bestCost < std::numeric_limits<GLfloat>::max())
+		middle = std::partition(order.begin() + begin, order.begin() + end, [&](GLuint t) { return binOf(bestAxis, t) < bestSplit; }) - order.begin();
+	else
+	{
+		//all centroids in one bin, median split along the longest axis
+		size_t axis = extent.x > extent.y ? (extent.x > extent.z ? 0 : 2) : (extent.y > extent.z ? 1 : 2);
+		middle = begin + count / 2;
+		std::nth_element(order.begin() + begin, order.begin() + middle, order.begin() + end, [&](GLuint a, GLuint b) { return centroids[a][axis] < centroids[b][axis]; });
+	}
+
+	GLuint children = nodeCount.fetch_add(2);
+	_nodes[node]._first = children;
+	_nodes[node]._count = 0;
+
+	//children cover disjoint ranges of order and write their own nodes, so big subtrees are built on separate threads
+	size_t threads = std::max<size_t>(1, std::thread::hardware_concurrency());
+	if (count >= BVH_PARALLEL_SIZE && (size_t(1) << depth) < threads)
+		parallelTasks(2, [&](size_t t)
+		{
+			t == 0 ?
+				buildNode(children, begin, middle, depth + 1, order, bounds, centroids, nodeCount) :
+				buildNode(children + 1, middle, end, depth + 1, order, bounds, centroids, nodeCount);
+		});
+	else
+	{
+		buildNode(children, begin, middle, depth + 1, order, bounds, centroids, nodeCount);
+		buildNode(children + 1, middle, end, depth + 1, order, bounds, centroids, nodeCount);
+	}
+}
+
+GLfloat Bvh::closestPoint(const glm::vec3& p, glm::vec3& closest, GLfloat maxDistance2, GLuint* triangle) const
+{
+	GLfloat best = maxDistance2;
+	if (_nodes.empty())
+		return best;
+
+	//every level pops one node and pushes at most two, so the stack never holds more than BVH_MAX_DEPTH + 1 nodes
+	GLuint stack[BVH_MAX_DEPTH + 1];
+	size_t top = 0;
+	stack[top++] = 0;
+	while (top > 0)
+	{
+		const BvhNode& node = _nodes[stack[--top]];
+		if (boxDistance2(p, node) >= best)
+			continue;
+
+		if (node._count > 0)
+		{
+			for (GLuint i = node._first; i < node._first + node._count; ++i)
+			{
+				glm::vec3 c = closestPointOnTriangle(p, _triangles[i][0], _triangles[i][1], _triangles[i][2]);
+				GLfloat d = glm::dot(c - p, c - p);
+				if (d < best)
+				{
+					best = d;
+					closest = c;
+					if (triangle)
+						*triangle = _ids[i];
+				}
+			}
+			continue;
+		}
+
+		//the nearer child is popped first, so the farther one is often culled
+		GLuint nearChild = node._first;
+		GLuint farChild = node._first + 1;
+		GLfloat nearDistance = boxDistance2(p, _nodes[nearChild]);
+		GLfloat farDistance = boxDistance2(p, _nodes[farChild]);
+		if (farDistance < nearDistance)
+		{
+			std::swap(nearChild, farChild);
+			std::swap(nearDistance, farDistance);
+		}
+		if (farDistance < best)
+			stack[top++] = farChild;
+		if (nearDistance < best)
+			stack[top++] = nearChild;
+	}
+	return best;
+}
+
+void Bvh::project(size_t count, GLfloat* x, GLfloat* y, GLfloat* z) const
+{
+	if (empty())
+		return;
+
+	parallelFor(0, count, [&](size_t i)
+	{
+		glm::vec3 p(x[i], y[i], z[i]);
+		glm::vec3 closest = p;
+		closestPoint(p, closest);
+		x[i] = closest.x;
+		y[i] = closest.y;
+		z[i] = closest.z;
+	});
+}
\ No newline at end of file
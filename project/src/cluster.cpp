@@ -0,0 +1,132 @@
+#include "../include/cluster.h"
+
+Frustum::Frustum(const glm::mat4& matrix)
+{
+	//rows of the matrix, glm stores columns
+	glm::vec4 rows[4];
+	for (int r = 0; r < 4; ++r)
+		rows[r] = glm::vec4(matrix[0][r], matrix[1][r], matrix[2][r], matrix[3][r]);
+
+	_planes[0] = rows[3] + rows[0];
+	_planes[1] = rows[3] - rows[0];
+	_planes[2] = rows[3] + rows[1];
+	_planes[3] = rows[3] - rows[1];
+	_planes[4] = rows[3] + rows[2];
+	_planes[5] = rows[3] - rows[2];
+	for (auto& p : _planes)
+	{
+		GLfloat length = glm::length(glm::vec3(p));
+		if (length > .0f)
+			p /= length;
+	}
+}
+
+BoundingSphere boundingSphere(const std::vector<glm::vec3>& positions, const std::vector<GLuint>& indices, size_t first, size_t count)
+{
+	BoundingSphere sphere;
+	if (count == 0)
+		return sphere;
+
+	glm::vec3 minimum(std::numeric_limits<GLfloat>::max());
+	glm::vec3 maximum(-std::numeric_limits<GLfloat>::max());
+	for (size_t i = first; i < first + count; ++i)
+	{
+		minimum = glm::min(minimum, positions[indices[i]]);
+		maximum = glm::max(maximum, positions[indices[i]]);
+	}
+	sphere._center = .5f * (minimum + maximum);
+	for (size_t i = first; i < first + count; ++i)
+		sphere._radius = std::max(sphere._radius, glm::distance(sphere._center, positions[indices[i]]));
+	return sphere;
+}
+
+/**
+ * computes bounds and normal cone of a cluster
+ * @param cluster cluster with its range set
+ * @param positions vertex positions
+ * @param normals vertex normals (empty - no cone)
+ * @param indices triangle list
+ */
+static void finishCluster(Cluster& cluster, const std::vector<glm::vec3>& positions, const std::vector<glm::vec3>& normals, const std::vector<GLuint>& indices)
+{
+	cluster._bounds = boundingSphere(positions, indices, cluster._firstIndex, cluster._count);
+	if (normals.empty())
+		return;
+
+	//triangle normals are oriented by the vertex normals, a triangle without them disables the cone
+	std::vector<glm::vec3> faceNormals;
+	faceNormals.reserve(cluster._count / 3);
+	glm::vec3 axis(.0f);
+	for (size_t i = cluster._firstIndex; i < cluster._firstIndex + cluster._count; i += 3)
+	{
+		const glm::vec3& a = positions[indices[i]];
+		glm::vec3 n = glm::cross(positions[indices[i + 1]] - a, positions[indices[i + 2]] - a);
+		GLfloat length = glm::length(n);
+		if (length <= .0f)
+			continue;
+
+		GLfloat side = glm::dot(n, normals[indices[i]] + normals[indices[i + 1]] + normals[indices[i + 2]]);
+		if (side == .0f)
+			return;
+		n *= (side > .0f ? 1.f : -1.f) / length;
+		faceNormals.push_back(n);
+		axis += n;
+	}
+
+	GLfloat length = glm::length(axis);
+	if (faceNormals.empty() || length <= .0f)
+		return;
+	axis /= length;
+
+	GLfloat minimum = 1.f;
+	for (auto& n : faceNormals)
+		minimum = std::min(minimum, glm::dot(axis, n));
+	if (minimum <= CLUSTER_CONE_LIMIT)
+		return;
+
+	cluster._coneAxis = axis;
+	cluster._coneCutoff = std::sqrt(1.f - minimum * minimum);
+}
+
+std::vector<Cluster> buildClusters(const std::vector<glm::vec3>& positions, const std::vector<glm::vec3>& normals, const std::vector<GLuint>& indices)
+{
+	std::vector<Cluster> clusters;
+
+	//cluster which used a vertex last
+	std::vector<GLuint> used(positions.size(), std::numeric_limits<GLuint>::max());
+	GLuint vertices = 0;
+	Cluster cluster;
+	for (size_t i = 0; i + 2 < indices.size(); i += 3)
+	{
+		GLuint id = static_cast<GLuint>(clusters.size());
+		GLuint added = 0;
+		for (size_t k = 0; k < 3; ++k)
+			added += used[indices[i + k]] != id && (k == 0 || indices[i + k] != indices[i]) && (k < 2 || indices[i + 2] != indices[i + 1]);
+
+		//full cluster, the triangle starts the next one
+		if (cluster._count == 3 * CLUSTER_TRIANGLES || (cluster._count > 0 && vertices + added > CLUSTER_VERTICES))
+		{
+			finishCluster(cluster, positions, normals, indices);
+			clusters.push_back(cluster);
+			cluster = Cluster();
+			cluster._firstIndex = static_cast<GLuint>(i);
+			vertices = 0;
+			++id;
+		}
+
+		for (size_t k = 0; k < 3; ++k)
+			if (used[indices[i + k]] != id)
+			{
+				used[indices[i + k]] = id;
+				++vertices;
+			}
+		cluster._count += 3;
+	}
+
+	if (cluster._count > 0)
+	{
+		finishCluster(cluster, positions, normals, indices);
+		clusters.push_back(cluster);
+	}
+	return clusters;
+}
\ No newline at end of file
@@ -0,0 +1,119 @@
+#include "../include/deviation.h"
+
+/**
+ * next value of splitmix64 generator
+ * @param state generator state, advanced
+ * @return random value
+ */
+static inline uint64_t splitmix(uint64_t& state)
+{
+	uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+	z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+	z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+	return z ^ (z >> 31);
+}
+
+/**
+ * uniform number in [0, 1)
+ * @param state generator state, advanced
+ * @return random number
+ */
+static inline GLdouble uniform(uint64_t& state)
+{
+	return (splitmix(state) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+Deviation sampleDeviation(const std::vector<glm::vec3>& positions, const std::vector<std::array<GLuint, 3>>& triangles, const Bvh& target, size_t samples, uint32_t seed)
+{
+	Deviation deviation;
+	if (triangles.empty() || target.empty())
+		return deviation;
+
+	//running sum of triangle areas, samples pick triangles by binary search
+	std::vector<GLdouble> areas(triangles.size());
+	GLdouble area = 0.0;
+	for (size_t f = 0; f < triangles.size(); ++f)
+	{
+		const std::array<GLuint, 3>& t = triangles[f];
+		area += .5 * glm::length(glm::cross(positions[t[1]] - positions[t[0]], positions[t[2]] - positions[t[0]]));
+		areas[f] = area;
+	}
+	if (area <= 0.0)
+		samples = 0;
+
+	//vertices first, then area samples; sample i always lands at the same point
+	size_t count = positions.size() + samples;
+	auto samplePoint = [&](size_t i)
+	{
+		if (i < positions.size())
+			return positions[i];
+
+		uint64_t state = (static_cast<uint64_t>(seed) << 32) ^ i;
+		size_t f = std::upper_bound(areas.begin(), areas.end(), uniform(state) * area) - areas.begin();
+		f = std::min(f, triangles.size() - 1);
+		GLdouble r1 = uniform(state);
+		GLdouble r2 = uniform(state);
+		if (r1 + r2 > 1.0)
+		{
+			r1 = 1.0 - r1;
+			r2 = 1.0 - r2;
+		}
+		const std::array<GLuint, 3>& t = triangles[f];
+		return positions[t[0]] + static_cast<GLfloat>(r1) * (positions[t[1]] - positions[t[0]]) + static_cast<GLfloat>(r2) * (positions[t[2]] - positions[t[0]]);
+	};
+
+	//one partial result per block, blocks are combined in order; blocks are expensive, so each one may go to its own thread
+	size_t blocks = (count + DEVIATION_BLOCK - 1) / DEVIATION_BLOCK;
+	std::vector<std::array<GLdouble, 3>> partial(blocks);
+	parallelFor(0, blocks, [&](size_t b)
+	{
+		std::array<GLdouble, 3> block = { { 0.0, 0.0, 0.0 } };
+		for (size_t i = b * DEVIATION_BLOCK; i < std::min(count, (b + 1) * DEVIATION_BLOCK); ++i)
+		{
+			glm::vec3 p = samplePoint(i);
+			glm::vec3 closest = p;
+			GLdouble distance2 = target.closestPoint(p, closest);
+			GLdouble distance = std::sqrt(distance2);
+			block[0] = std::max(block[0], distance);
+			block[1] += distance;
+			block[2] += distance2;
+		}
+		partial[b] = block;
+	}, 1);
+
+	GLdouble sum = 0.0;
+	GLdouble sum2 = 0.0;
+	for (auto& block : partial)
+	{
+		deviation._max = std::max(deviation._max, block[0]);
+		sum += block[1];
+		sum2 += block[2];
+	}
+	deviation._samples = count;
+	deviation._mean = sum / count;
+	deviation._rms = std::sqrt(sum2 / count);
+	return deviation;
+}
+
+SurfaceDeviation surfaceDeviation
+(
+	const std::vector<glm::vec3>& positionsA,
+	const std::vector<std::array<GLuint, 3>>& trianglesA,
+	const std::vector<glm::vec3>& positionsB,
+	const std::vector<std::array<GLuint, 3>>& trianglesB,
+	size_t samples,
+	uint32_t seed
+)
+{
+	Bvh bvhA;
+	Bvh bvhB;
+	parallelTasks(2, [&](size_t t)
+	{
+		t == 0 ? bvhA.build(positionsA, trianglesA) : bvhB.build(positionsB, trianglesB);
+	});
+
+	SurfaceDeviation deviation;
+	deviation._forward = sampleDeviation(positionsA, trianglesA, bvhB, samples, seed);
+	deviation._backward = sampleDeviation(positionsB, trianglesB, bvhA, samples, seed);
+	return deviation;
+}
\ No newline at end of file
@@ -0,0 +1,221 @@
+#include "../include/edgeCost.h"
+
+//MSVC compiles intrinsics of any instruction set, GCC and Clang need them enabled per function
+#if defined(SIMD_X86) && defined(__GNUC__)
+#define TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define TARGET_AVX2
+#endif
+
+simdLevel simdSupported()
+{
+	static const simdLevel level = []()
+	{
+#if defined(SIMD_X86) && defined(_MSC_VER)
+		int info[4];
+		__cpuid(info, 0);
+		if (info[0] < 7)
+			return SIMD_SSE;
+
+		//AVX2 needs OS support of YMM registers (OSXSAVE and XCR0 bits 1, 2)
+		__cpuid(info, 1);
+		bool osYmm = (info[2] & (1 << 27)) && (_xgetbv(0) & 6) == 6;
+		__cpuidex(info, 7, 0);
+		return osYmm && (info[1] & (1 << 5)) ? SIMD_AVX2 : SIMD_SSE;
+#elif defined(SIMD_X86) && defined(__GNUC__)
+		__builtin_cpu_init();
+		return __builtin_cpu_supports("avx2") ? SIMD_AVX2 : SIMD_SSE;
+#else
+		return SIMD_SCALAR;
+#endif
+	}();
+	return level;
+}
+
+const char* simdName(simdLevel level)
+{
+	switch (level)
+	{
+	case SIMD_AVX2:
+		return "AVX2";
+	case SIMD_SSE:
+		return "SSE";
+	default:
+		return "scalar";
+	}
+}
+
+/**
+ * cost of midpoint v = (x, y, z, 1) for summed upper triangle coefficients
+ * @param x x coordinate
+ * @param y y coordinate
+ * @param z z coordinate
+ * @param q coefficients (a00 a01 a02 a03 a11 a12 a13 a22 a23 a33)
+ * @return max(v^T * Q * v, 0)
+ */
+static inline GLfloat quadricCost(GLfloat x, GLfloat y, GLfloat z, const GLfloat* q)
+{
+	GLfloat cost =
+		x * (q[0] * x + 2.f * (q[1] * y + q[2] * z + q[3])) +
+		y * (q[4] * y + 2.f * (q[5] * z + q[6])) +
+		z * (q[7] * z + 2.f * q[8]) +
+		q[9];
+	return std::max(cost, .0f);
+}
+
+GLfloat edgeCost(const glm::vec3& a, const glm::vec3& b, const glm::mat4& qa, const glm::mat4& qb)
+{
+	GLfloat q[10];
+	size_t k = 0;
+	for (size_t r = 0; r < 4; ++r)
+		for (size_t c = r; c < 4; ++c)
+			q[k++] = qa[c][r] + qb[c][r];
+	return quadricCost((a.x + b.x) * .5f, (a.y + b.y) * .5f, (a.z + b.z) * .5f, q);
+}
+
+/**
+ * scalar kernel, also used for the remainder of vector kernels
+ * @param in pointers to slot and edge arrays
+ * @param begin first edge
+ * @param end one past the last edge
+ * @param costs output array
+ */
+static void edgeCostScalar(const EdgeCostInput& in, size_t begin, size_t end, GLfloat* costs)
+{
+	for (size_t i = begin; i < end; ++i)
+	{
+		GLuint a = in._a[i];
+		GLuint b = in._b[i];
+
+		//midpoint and summed quadric
+		GLfloat x = (in._x[a] + in._x[b]) * .5f;
+		GLfloat y = (in._y[a] + in._y[b]) * .5f;
+		GLfloat z = (in._z[a] + in._z[b]) * .5f;
+		GLfloat q[10];
+		for (size_t k = 0; k < 10; ++k)
+			q[k] = in._quad[k][a] + in._quad[k][b];
+		costs[i] = quadricCost(x, y, z, q);
+	}
+}
+
+#if defined(SIMD_X86)
+/**
+ * sum of values of 4 edges' slots
+ * @param p array indexed by slot
+ * @param a first slots of edges
+ * @param b second slots of edges
+ * @return vector of sums
+ */
+static inline __m128 gatherSumSSE(const GLfloat* p, const GLuint* a, const GLuint* b)
+{
+	return _mm_add_ps(_mm_set_ps(p[a[3]], p[a[2]], p[a[1]], p[a[0]]), _mm_set_ps(p[b[3]], p[b[2]], p[b[1]], p[b[0]]));
+}
+
+/**
+ * SSE kernel, 4 edges per iteration
+ * @param in pointers to slot and edge arrays
+ * @param count number of edges
+ * @param costs output array
+ */
+static void edgeCostSSE(const EdgeCostInput& in, size_t count, GLfloat* costs)
+{
+	const __m128 half = _mm_set1_ps(.5f);
+	const __m128 two = _mm_set1_ps(2.f);
+	const __m128 zero = _mm_setzero_ps();
+
+	size_t i = 0;
+	for (; i + 4 <= count; i += 4)
+	{
+		const GLuint* a = in._a + i;
+		const GLuint* b = in._b + i;
+
+		__m128 x = _mm_mul_ps(gatherSumSSE(in._x, a, b), half);
+		__m128 y = _mm_mul_ps(gatherSumSSE(in._y, a, b), half);
+		__m128 z = _mm_mul_ps(gatherSumSSE(in._z, a, b), half);
+		__m128 q[10];
+		for (size_t k = 0; k < 10; ++k)
+			q[k] = gatherSumSSE(in._quad[k], a, b);
+
+		//same order of operations as quadricCost, so every level gives bit-identical costs
+		__m128 rx = _mm_add_ps(_mm_add_ps(_mm_mul_ps(q[1], y), _mm_mul_ps(q[2], z)), q[3]);
+		rx = _mm_mul_ps(x, _mm_add_ps(_mm_mul_ps(q[0], x), _mm_mul_ps(two, rx)));
+		__m128 ry = _mm_add_ps(_mm_mul_ps(q[5], z), q[6]);
+		ry = _mm_mul_ps(y, _mm_add_ps(_mm_mul_ps(q[4], y), _mm_mul_ps(two, ry)));
+		__m128 rz = _mm_mul_ps(z, _mm_add_ps(_mm_mul_ps(q[7], z), _mm_mul_ps(two, q[8])));
+
+		__m128 cost = _mm_add_ps(_mm_add_ps(_mm_add_ps(rx, ry), rz), q[9]);
+		_mm_storeu_ps(costs + i, _mm_max_ps(cost, zero));
+	}
+	edgeCostScalar(in, i, count, costs);
+}
+
+/**
+ * sum of values of 8 edges' slots
+ * @param p array indexed by slot
+ * @param a first slots of edges
+ * @param b second slots of edges
+ * @return vector of sums
+ */
+TARGET_AVX2 static inline __m256 gatherSumAVX2(const GLfloat* p, __m256i a, __m256i b)
+{
+	return _mm256_add_ps(_mm256_i32gather_ps(p, a, 4), _mm256_i32gather_ps(p, b, 4));
+}
+
+/**
+ * AVX2 kernel, 8 edges per iteration
+ * @param in pointers to slot and edge arrays
+ * @param count number of edges
+ * @param costs output array
+ */
+TARGET_AVX2 static void edgeCostAVX2(const EdgeCostInput& in, size_t count, GLfloat* costs)
+{
+	const __m256 half = _mm256_set1_ps(.5f);
+	const __m256 two = _mm256_set1_ps(2.f);
+	const __m256 zero = _mm256_setzero_ps();
+
+	size_t i = 0;
+	for (; i + 8 <= count; i += 8)
+	{
+		__m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in._a + i));
+		__m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in._b + i));
+
+		__m256 x = _mm256_mul_ps(gatherSumAVX2(in._x, a, b), half);
+		__m256 y = _mm256_mul_ps(gatherSumAVX2(in._y, a, b), half);
+		__m256 z = _mm256_mul_ps(gatherSumAVX2(in._z, a, b), half);
+		__m256 q[10];
+		for (size_t k = 0; k < 10; ++k)
+			q[k] = gatherSumAVX2(in._quad[k], a, b);
+
+		//same order of operations as quadricCost, so every level gives bit-identical costs
+		__m256 rx = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(q[1], y), _mm256_mul_ps(q[2], z)), q[3]);
+		rx = _mm256_mul_ps(x, _mm256_add_ps(_mm256_mul_ps(q[0], x), _mm256_mul_ps(two, rx)));
+		__m256 ry = _mm256_add_ps(_mm256_mul_ps(q[5], z), q[6]);
+		ry = _mm256_mul_ps(y, _mm256_add_ps(_mm256_mul_ps(q[4], y), _mm256_mul_ps(two, ry)));
+		__m256 rz = _mm256_mul_ps(z, _mm256_add_ps(_mm256_mul_ps(q[7], z), _mm256_mul_ps(two, q[8])));
+
+		__m256 cost = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(rx, ry), rz), q[9]);
+		_mm256_storeu_ps(costs + i, _mm256_max_ps(cost, zero));
+	}
+
+	//dirty upper halves of YMM registers slow down every following SSE instruction
+	_mm256_zeroupper();
+	edgeCostScalar(in, i, count, costs);
+}
+#endif
+
+void edgeCostKernel(const EdgeCostInput& input, size_t count, GLfloat* costs, simdLevel level)
+{
+	switch (level)
+	{
+#if defined(SIMD_X86)
+	case SIMD_AVX2:
+		edgeCostAVX2(input, count, costs);
+		break;
+	case SIMD_SSE:
+		edgeCostSSE(input, count, costs);
+		break;
+#endif
+	default:
+		edgeCostScalar(input, 0, count, costs);
+	}
+}
\ No newline at end of file
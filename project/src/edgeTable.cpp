@@ -0,0 +1,35 @@
+#include "../include/edgeTable.h"
+
+void EdgeTable::build(const std::vector<Face>& faces)
+{
+	//one record per side of every face: key and position of the face
+	struct SideRecord
+	{
+		uint64_t _key;
+		GLuint _face;
+	};
+	std::vector<SideRecord> sides(3 * faces.size());
+	parallelFor(0, faces.size(), [&](size_t i)
+	{
+		const Face& f = faces[i];
+		sides[3 * i] = { key(f._vertices[0], f._vertices[1]), static_cast<GLuint>(i) };
+		sides[3 * i + 1] = { key(f._vertices[1], f._vertices[2]), static_cast<GLuint>(i) };
+		sides[3 * i + 2] = { key(f._vertices[0], f._vertices[2]), static_cast<GLuint>(i) };
+	});
+	parallelRadixSort(sides, [](const SideRecord& s) { return s._key; });
+
+	//equal keys are adjacent, every run is one edge
+	_keys.clear();
+	_faces.clear();
+	_faceCounts.clear();
+	for (size_t begin = 0, end; begin < sides.size(); begin = end)
+	{
+		end = begin + 1;
+		while (end < sides.size() && sides[end]._key == sides[begin]._key)
+			++end;
+
+		_keys.push_back(sides[begin]._key);
+		_faces.push_back({ { sides[begin]._face, end - begin > 1 ? sides[begin + 1]._face : NO_FACE } });
+		_faceCounts.push_back(end - begin);
+	}
+}
\ No newline at end of file
@@ -1,142 +1,256 @@
-#include "../include/gui.h"
-
-Gui::Gui
-(
-	const char* title,
-	const int width, const int height,
-	const int GLverMajor, const int GLverMinor,
-	bool resizable
-)
-{
-	_app = new App(title, width, height, GLverMajor, GLverMinor, resizable);
-}
-
-void Gui::newFrame()
-{
-	ImGui_ImplOpenGL3_NewFrame();
-	ImGui_ImplGlfw_NewFrame();
-	ImGui::NewFrame();
-}
-
-void Gui::clear()
-{
-	glClearColor(.25f, .25f, .25f, 1.f);
-	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-}
-
-void Gui::render()
-{
-	ImGui::Begin("front panel", 0, 1 | 2 | 4);
-	ImGui::SetWindowSize({ 350, 700 });
-	ImGui::SetWindowPos({ 10, 10 });
-	ImGui::Text("Use WSAD to move the camera.\nDrag the mouse cursor to rotate the camera.");
-	if (ImGui::Button("reset the camera"))
-	{
-		_app->_camera.reset();
-	}
-
-	ImGui::Text("camera speed");
-	ImGui::InputFloat("##camSpeed", &_app->_camera._movementSpeed);
-	ImGui::SameLine();
-	if (ImGui::Button("reset"))
-	{
-		_app->_camera._movementSpeed = 10.f;
-	}
-
-	ImGui::Text("\nfile path");
-	ImGui::InputText("##filePath", _filePath, 100);
-	ImGui::Text("simplify modifier (%%)");
-	ImGui::SliderFloat("##percentage", &_percentage, 0.f, 100.f);
-	if (ImGui::Button("load & calculate"))
-	{
-		_log = ">loading";
-		_toInit = true;
-	}
-	ImGui::SameLine();
-	ImGui::Text((_log).c_str());
-
-	ImGui::Text("\n");
-	ImGui::Checkbox("filled polygons", &_filledPolygons);
-
-	ImGui::Text("\n");
-	if (ImGui::RadioButton("original model", &_meshMode, 0)) { _filledPolygons = true; }
-	if (ImGui::RadioButton("original mesh", &_meshMode, 1)) { _filledPolygons = false; }
-	if (ImGui::RadioButton("simplified mesh", &_meshMode, 2)) { _filledPolygons = false; }
-	if (ImGui::RadioButton("quasi-regular mesh", &_meshMode, 3)) { _filledPolygons = false; }
-
-	if (_app->_models.size() == 4 && _app->_models[0]->_meshes[0]->_vertices.size() > 0)
-	{
-		ImGui::Text("\n\n\n\n\n\n\n\n\n\n\n\n\n\n\n\n");
-		ImGui::Text(static_cast<std::string>("original mesh vertices count: " + std::to_string(_app->_models[1]->_meshes[0]->_simpleVertices.size())).c_str());
-		ImGui::Text(static_cast<std::string>("\nsimplified mesh vertices count: " + std::to_string(_app->_models[2]->_meshes[0]->_simpleVertices.size())).c_str());
-		ImGui::Text(static_cast<std::string>("processing time: " + std::to_string(_app->_models[2]->_meshes[0]->_simplifyTime) + " s").c_str());
-		ImGui::Text(static_cast<std::string>("\nquasi-regular mesh vertices count: " + std::to_string(_app->_models[3]->_meshes[0]->_simpleVertices.size())).c_str());
-		ImGui::Text(static_cast<std::string>("processing time: " + std::to_string(_app->_models[3]->_meshes[0]->_aeapTime) + " s").c_str());
-	}
-
-	ImGui::End();
-
-	ImGui::Render();
-	ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
-}
-
-void Gui::shutdown()
-{
-	ImGui_ImplOpenGL3_Shutdown();
-	ImGui_ImplGlfw_Shutdown();
-	ImGui::DestroyContext();
-}
-
-void Gui::loop()
-{
-	IMGUI_CHECKVERSION();
-	ImGui::CreateContext();
-	ImGuiIO& io = ImGui::GetIO();
-	ImGui_ImplGlfw_InitForOpenGL(_app->_window, true);
-	ImGui_ImplOpenGL3_Init("#version 130");
-	ImGui::StyleColorsLight();
-
-	while (!_app->getWindowShouldClose())
-	{
-		newFrame();
-
-		_app->update();
-		_app->render(_meshMode);
-
-		if (_toInit)
-		{
-			_app->initModels
-			(
-				_filePath,	//obj file name
-				glm::vec3(-6.f, 1.f, -4.f),	//position
-				glm::vec3(90.0f, 180.0f, 0.0f),	//rotation
-				glm::vec3(1.f),	//scale
-				glm::vec3(1.f, .5f, .0f),	//vertex color
-				_percentage / 100.f //percentage of the number of vertices (simplified : original)
-			);
-
-			_log = ObjLoader::_log;
-			_toInit = false;
-		}
-
-		render();
-
-		switch (_filledPolygons)
-		{
-		case true:
-			App::_polygonMode = GL_FILL;
-			break;
-		default:
-			App::_polygonMode = GL_LINE;
-			break;
-		}
-
-		glfwPollEvents();
-		glfwSwapBuffers(_app->_window);
-		glFlush();
-
-		clear();
-	}
-
-	shutdown();
+#include "../include/gui.h"
+
+Gui::Gui
+(
+	const char* title,
+	const int width, const int height,
+	const int GLverMajor, const int GLverMinor,
+	bool resizable
+)
+{
+	_app = new App(title, width, height, GLverMajor, GLverMinor, resizable);
+}
+
+SimplifyTarget Gui::getSimplifyTarget()
+{
+	SimplifyTarget target;
+	switch (_targetMode)
+	{
+	case 1:
+		target = SimplifyTarget(_maxError, 0);
+		break;
+	case 2:
+		target = SimplifyTarget(-1.f, static_cast<size_t>(std::max(_targetFaces, 1)));
+		break;
+	case 3:
+		target = SimplifyTarget::screenSpace(_pixelError, _viewDistance, _app->_fov, static_cast<GLfloat>(_app->_framebufferHeight), static_cast<size_t>(std::max(_targetFaces, 0)));
+		break;
+	default:
+		target = SimplifyTarget(_percentage / 100.f);	//percentage of the number of vertices (simplified : original)
+		break;
+	}
+
+	if (_clustering)
+		target.clustering();
+
+	return target;
+}
+
+void Gui::newFrame()
+{
+	ImGui_ImplOpenGL3_NewFrame();
+	ImGui_ImplGlfw_NewFrame();
+	ImGui::NewFrame();
+}
+
+void Gui::clear()
+{
+	glClearColor(.25f, .25f, .25f, 1.f);
+	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+}
+
+void Gui::render()
+{
+	ImGui::Begin("front panel", 0, 1 | 2 | 4);
+	ImGui::SetWindowSize({ 350, 700 });
+	ImGui::SetWindowPos({ 10, 10 });
+	ImGui::Text("Use WSAD to move the camera.\nDrag the mouse cursor to rotate the camera.");
+	if (ImGui::Button("reset the camera"))
+	{
+		_app->_camera.reset();
+	}
+
+	ImGui::Text("camera speed");
+	ImGui::InputFloat("##camSpeed", &_app->_camera._movementSpeed);
+	ImGui::SameLine();
+	if (ImGui::Button("reset"))
+	{
+		_app->_camera._movementSpeed = 10.f;
+	}
+
+	ImGui::Text("\nfile path");
+	ImGui::InputText("##filePath", _filePath, 100);
+	ImGui::Text("simplify until");
+	ImGui::RadioButton("vertices %", &_targetMode, 0);
+	ImGui::SameLine();
+	ImGui::RadioButton("error", &_targetMode, 1);
+	ImGui::SameLine();
+	ImGui::RadioButton("triangles", &_targetMode, 2);
+	ImGui::SameLine();
+	ImGui::RadioButton("pixels", &_targetMode, 3);
+	switch (_targetMode)
+	{
+	case 1:
+		ImGui::InputFloat("max error##maxError", &_maxError, .0f, .0f, "%.6f");
+		break;
+	case 2:
+		ImGui::InputInt("triangles##targetFaces", &_targetFaces);
+		break;
+	case 3:
+		ImGui::InputFloat("pixels##pixelError", &_pixelError);
+		ImGui::InputFloat("distance##viewDistance", &_viewDistance);
+		ImGui::InputInt("budget##targetFaces", &_targetFaces);
+		break;
+	default:
+		ImGui::SliderFloat("##percentage", &_percentage, 0.f, 100.f);
+		break;
+	}
+	ImGui::Checkbox("fast clustering (preview)", &_clustering);
+	ImGui::Checkbox("live preview", &_livePreview);
+	if (ImGui::Button("load & calculate"))
+	{
+		_log = ">loading";
+		_toInit = true;
+	}
+	ImGui::SameLine();
+	ImGui::Text((_log).c_str());
+
+	ImGui::Text("\n");
+	ImGui::Checkbox("filled polygons", &_filledPolygons);
+
+	ImGui::Text("\n");
+	if (ImGui::RadioButton("original model", &_meshMode, 0)) { _filledPolygons = true; }
+	if (ImGui::RadioButton("original mesh", &_meshMode, 1)) { _filledPolygons = false; }
+	if (ImGui::RadioButton("simplified mesh", &_meshMode, 2)) { _filledPolygons = false; }
+	if (ImGui::RadioButton("quasi-regular mesh", &_meshMode, 3)) { _filledPolygons = false; }
+	if (ImGui::RadioButton("simplified model", &_meshMode, 4)) { _filledPolygons = true; }
+	if (ImGui::RadioButton("scene (batched)", &_meshMode, SCENE_MODE)) { _filledPolygons = true; }
+	ImGui::InputFloat("LOD pixels##lodPixelError", &_app->_lodPixelError);
+
+	if (_app->_models.size() == 5 && _app->_models[0]->_meshes[0]->_vertices.size() > 0)
+	{
+		ImGui::Text("\n\n\n\n\n\n\n\n");
+		ImGui::Text(static_cast<std::string>("original mesh vertices count: " + std::to_string(_app->_models[1]->_meshes[0]->_simpleVertices.size())).c_str());
+		ImGui::Text(static_cast<std::string>("\nsimplified mesh vertices count: " + std::to_string(_app->_models[2]->_meshes[0]->_simpleVertices.size())).c_str());
+		ImGui::Text(static_cast<std::string>("simplified mesh triangles count: " + std::to_string(_app->_models[2]->_meshes[0]->_faces.size())).c_str());
+		ImGui::Text(static_cast<std::string>("simplified mesh adjacency: " + std::to_string(_app->_models[2]->_meshes[0]->adjacencyBytes() / std::max<size_t>(1, _app->_models[2]->_meshes[0]->_simpleVertices.size())) + " B per vertex").c_str());
+		ImGui::Text(static_cast<std::string>("simplified model vertices count: " + std::to_string(_app->_models[4]->_meshes[0]->_vertices.size())).c_str());
+		ImGui::Text(static_cast<std::string>("vertex buffers (mesh, model): " + std::to_string(_app->_models[2]->_meshes[0]->_vertexBufferBytes / 1024) + " kB, " + std::to_string(_app->_models[4]->_meshes[0]->_vertexBufferBytes / 1024) + " kB").c_str());
+		const Mesh* simplifiedModel = _app->_models[4]->_meshes[0];
+		const QuantizationError& quantization = simplifiedModel->_quantizationError;
+		ImGui::Text(static_cast<std::string>("quantization error: position " + std::to_string(quantization._positionRelative * 100.f) + " % of diagonal, normal " + std::to_string(quantization._normal) + " deg, texcoord " + std::to_string(quantization._texcoord)).c_str());
+		ImGui::Text(static_cast<std::string>("index buffer (model): " + std::to_string(simplifiedModel->_indexBufferBytes / 1024) + " kB " + (simplifiedModel->_indexType == GL_UNSIGNED_SHORT ? "16-bit" : "32-bit") + ", compressed " + std::to_string(simplifiedModel->_compressedIndexBytes / 1024) + " kB").c_str());
+		if (ImGui::Button("export indices"))
+		{
+			std::string fileName = static_cast<std::string>(_filePath) + ".idx";
+			_log = simplifiedModel->exportIndices(fileName.c_str()) ? ">indices saved to " + fileName : ">indices could not be saved";
+		}
+		ImGui::Text(static_cast<std::string>("vertex cache (model, ACMR / ATVR): " + std::to_string(simplifiedModel->_cacheBefore._acmr) + " / " + std::to_string(simplifiedModel->_cacheBefore._atvr) + " -> " + std::to_string(simplifiedModel->_cacheAfter._acmr) + " / " + std::to_string(simplifiedModel->_cacheAfter._atvr)).c_str());
+		if (_meshMode != SCENE_MODE)
+		{
+			const Mesh* shown = _app->_models[_meshMode]->_meshes[0];
+			ImGui::Text(static_cast<std::string>("culling: " + std::to_string(shown->getVisibleClusters()) + " / " + std::to_string(shown->getClusterCount()) + " clusters, " + std::to_string(shown->getVisibleTriangles()) + " triangles drawn").c_str());
+		}
+		if (_app->_batch)
+		{
+			ImGui::Text(static_cast<std::string>("scene: " + std::to_string(_app->_batch->instances()) + " instances, " + std::to_string(_app->_batch->commands()) + " indirect commands in 1 draw call").c_str());
+			size_t coarse = std::count(_app->_sceneLod.begin(), _app->_sceneLod.end(), _app->_sceneLevels.size() - 1);
+			ImGui::Text(static_cast<std::string>("scene LOD: " + std::to_string(_app->_sceneTriangles) + " triangles, " + std::to_string(coarse) + " instances at the coarsest level, " + std::to_string(_app->_sceneVisible) + " in view").c_str());
+		}
+		ImGui::Text(static_cast<std::string>("highest collapse error: " + std::to_string(_app->_models[2]->_meshes[0]->_simplifyError)).c_str());
+		ImGui::Text(static_cast<std::string>("processing time: " + std::to_string(_app->_models[2]->_meshes[0]->_simplifyTime) + " s").c_str());
+		const SurfaceDeviation& simplified = _app->_models[2]->_meshes[0]->_simplifyDeviation;
+		ImGui::Text(static_cast<std::string>("deviation: max " + std::to_string(simplified.hausdorff()) + ", mean " + std::to_string(simplified.mean()) + ", rms " + std::to_string(simplified.rms())).c_str());
+		ImGui::Text(static_cast<std::string>("\nquasi-regular mesh vertices count: " + std::to_string(_app->_models[3]->_meshes[0]->_simpleVertices.size())).c_str());
+		ImGui::Text(static_cast<std::string>("processing time: " + std::to_string(_app->_models[3]->_meshes[0]->_aeapTime) + " s").c_str());
+		const SurfaceDeviation& remeshed = _app->_models[3]->_meshes[0]->_remeshDeviation;
+		ImGui::Text(static_cast<std::string>("deviation from simplified mesh: max " + std::to_string(remeshed.hausdorff()) + ", mean " + std::to_string(remeshed.mean()) + ", rms " + std::to_string(remeshed.rms())).c_str());
+
+		//one line per remeshing iteration, the first one describes the simplified mesh
+		const Mesh* remeshMesh = _app->_models[3]->_meshes[0];
+		for (size_t i = 1; i < remeshMesh->_remeshLog.size(); ++i)
+		{
+			const RemeshIteration& it = remeshMesh->_remeshLog[i];
+			ImGui::Text(static_cast<std::string>
+			(
+				"iteration " + std::to_string(i) + (it._complete ? "" : " (out of time)") + (i == remeshMesh->_remeshBest ? " (kept)" : "") + ": " +
+				std::to_string(it.time()) + " s, " +
+				std::to_string(it._collapses) + " collapses " + std::to_string(it._collapseTime) + " s, " +
+				std::to_string(it._splits) + " splits " + std::to_string(it._splitTime) + " s, " +
+				std::to_string(it._flips) + " flips " + std::to_string(it._flipTime) + " s, " +
+				"relocation " + std::to_string(it._relocationTime) + " s, " +
+				"projection " + std::to_string(it._projectionTime) + " s, " +
+				std::to_string(100.f * it._inRange) + "% edges in range"
+			).c_str());
+		}
+	}
+
+	ImGui::End();
+
+	ImGui::Render();
+	ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+}
+
+void Gui::shutdown()
+{
+	ImGui_ImplOpenGL3_Shutdown();
+	ImGui_ImplGlfw_Shutdown();
+	ImGui::DestroyContext();
+}
+
+void Gui::loop()
+{
+	IMGUI_CHECKVERSION();
+	ImGui::CreateContext();
+	ImGuiIO& io = ImGui::GetIO();
+	ImGui_ImplGlfw_InitForOpenGL(_app->_window, true);
+	ImGui_ImplOpenGL3_Init("#version 130");
+	ImGui::StyleColorsLight();
+
+	while (!_app->getWindowShouldClose())
+	{
+		newFrame();
+
+		_app->update();
+		_app->render(_meshMode);
+
+		if (_toInit)
+		{
+			//meshes being processed are drawn as wireframes without the front panel, the ImGui frame stays open
+			if (_livePreview)
+			{
+				Mesh::_preview = [this](Mesh* mesh)
+				{
+					clear();
+					mesh->renderStream(_app->_shader, GL_LINE);
+					glfwSwapBuffers(_app->_window);
+					glfwPollEvents();
+				};
+			}
+
+			_app->initModels
+			(
+				_filePath,	//obj file name
+				glm::vec3(-6.f, 1.f, -4.f),	//position
+				glm::vec3(90.0f, 180.0f, 0.0f),	//rotation
+				glm::vec3(1.f),	//scale
+				glm::vec3(1.f, .5f, .0f),	//vertex color
+				getSimplifyTarget()	//stopping criteria of the simplification
+			);
+
+			Mesh::_preview = nullptr;
+			_log = ObjLoader::_log;
+			_toInit = false;
+		}
+
+		render();
+
+		switch (_filledPolygons)
+		{
+		case true:
+			App::_polygonMode = GL_FILL;
+			break;
+		default:
+			App::_polygonMode = GL_LINE;
+			break;
+		}
+
+		glfwPollEvents();
+		glfwSwapBuffers(_app->_window);
+		glFlush();
+
+		clear();
+	}
+
+	shutdown();
 }
\ No newline at end of file
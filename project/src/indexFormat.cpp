@@ -0,0 +1,126 @@
+#include "../include/indexFormat.h"
+
+/**
+ * appends LEB128 varint
+ * @param data encoded bytes
+ * @param value value
+ */
+static inline void writeVarint(std::vector<uint8_t>& data, uint32_t value)
+{
+	while (value >= 0x80)
+	{
+		data.push_back(static_cast<uint8_t>(value | 0x80));
+		value >>= 7;
+	}
+	data.push_back(static_cast<uint8_t>(value));
+}
+
+/**
+ * reads LEB128 varint
+ * @param data encoded bytes
+ * @param position read position, advanced
+ * @param value decoded value
+ * @return false if data end inside of the varint or it does not fit into 32 bits
+ */
+static inline bool readVarint(const std::vector<uint8_t>& data, size_t& position, uint32_t& value)
+{
+	value = 0;
+	for (uint32_t shift = 0; shift < 35; shift += 7)
+	{
+		if (position >= data.size())
+			return false;
+		uint8_t byte = data[position++];
+		//the fifth byte carries the top 4 bits only
+		if (shift == 28 && byte > 0x0f)
+			return false;
+		value |= static_cast<uint32_t>(byte & 0x7f) << shift;
+		if (!(byte & 0x80))
+			return true;
+	}
+	return false;
+}
+
+PackedIndices PackedIndices::pack(const std::vector<GLuint>& indices, size_t vertexCount)
+{
+	PackedIndices packed;
+	packed._count = static_cast<GLsizei>(indices.size());
+	if (vertexCount <= SHORT_INDEX_VERTICES)
+	{
+		packed._type = GL_UNSIGNED_SHORT;
+		packed._data.resize(indices.size() * sizeof(GLushort));
+		GLushort* data = reinterpret_cast<GLushort*>(packed._data.data());
+		for (size_t i = 0; i < indices.size(); ++i)
+			data[i] = static_cast<GLushort>(indices[i]);
+		return packed;
+	}
+
+	packed._type = GL_UNSIGNED_INT;
+	packed._data.resize(indices.size() * sizeof(GLuint));
+	if (!indices.empty())
+		std::memcpy(packed._data.data(), indices.data(), packed._data.size());
+	return packed;
+}
+
+std::vector<uint8_t> encodeIndices(const std::vector<GLuint>& indices)
+{
+	std::vector<uint8_t> data;
+	data.reserve(indices.size() + 5);
+	writeVarint(data, static_cast<uint32_t>(indices.size()));
+
+	uint32_t next = 0;
+	for (auto i : indices)
+	{
+		int32_t delta = static_cast<int32_t>(next - i);
+		writeVarint(data, (static_cast<uint32_t>(delta) << 1) ^ static_cast<uint32_t>(delta >> 31));
+		next = std::max(next, i + 1);
+	}
+	return data;
+}
+
+bool decodeIndices(const std::vector<uint8_t>& data, std::vector<GLuint>& indices)
+{
+	size_t position = 0;
+	uint32_t count = 0;
+	//every index takes at least one byte, which also bounds the allocation for malformed data
+	if (!readVarint(data, position, count) || count > data.size() - position)
+		return false;
+
+	indices.resize(count);
+	uint32_t next = 0;
+	for (auto& i : indices)
+	{
+		uint32_t code = 0;
+		if (!readVarint(data, position, code))
+			return false;
+		i = next - ((code >> 1) ^ (0u - (code & 1)));
+		next = std::max(next, i + 1);
+	}
+	return true;
+}
+
+bool saveIndices(const char* fileName, const std::vector<GLuint>& indices)
+{
+	std::ofstream outFile(fileName, std::ios::binary);
+	if (!outFile.is_open())
+		return false;
+
+	std::vector<uint8_t> data = encodeIndices(indices);
+	outFile.write(reinterpret_cast<const char*>(&INDEX_FILE_MAGIC), sizeof(INDEX_FILE_MAGIC));
+	outFile.write(reinterpret_cast<const char*>(data.data()), data.size());
+	return outFile.good();
+}
+
+bool loadIndices(const char* fileName, std::vector<GLuint>& indices)
+{
+	std::ifstream inFile(fileName, std::ios::binary);
+	if (!inFile.is_open())
+		return false;
+
+	uint32_t magic = 0;
+	inFile.read(reinterpret_cast<char*>(&magic), sizeof(magic));
+	if (!inFile || magic != INDEX_FILE_MAGIC)
+		return false;
+
+	std::vector<uint8_t> data((std::istreambuf_iterator<char>(inFile)), std::istreambuf_iterator<char>());
+	return decodeIndices(data, indices);
+}
\ No newline at end of file
@@ -0,0 +1,15 @@
+#include "../include/lod.h"
+
+size_t selectLod(const std::vector<LodLevel>& levels, GLfloat pixelsPerUnit, size_t current, GLfloat pixelError, GLfloat hysteresis)
+{
+	//coarsest level clearly under the tolerated error, the finest one if none is
+	size_t level = 0;
+	for (size_t i = 1; i < levels.size(); ++i)
+		if (levels[i]._error * pixelsPerUnit <= pixelError * (1.f - hysteresis))
+			level = i;
+
+	//a coarser current level inside the band is kept
+	if (current > level && current < levels.size() && levels[current]._error * pixelsPerUnit <= pixelError)
+		level = current;
+	return level;
+}
\ No newline at end of file
@@ -1,862 +1,1839 @@
-#include "../include/mesh.h"
-
-//private functions
-void Mesh::updateModelMatrix()
-{
-	_ModelMatrix = glm::mat4(1.f);
-	_ModelMatrix = glm::translate(_ModelMatrix, _origin);
-	_ModelMatrix = glm::rotate(_ModelMatrix, glm::radians(_rotation.x), glm::vec3(1.f, .0f, .0f));
-	_ModelMatrix = glm::rotate(_ModelMatrix, glm::radians(_rotation.y), glm::vec3(.0f, 1.f, .0f));
-	_ModelMatrix = glm::rotate(_ModelMatrix, glm::radians(_rotation.z), glm::vec3(.0f, .0f, 1.f));
-	_ModelMatrix = glm::translate(_ModelMatrix, _position - _origin);
-	_ModelMatrix = glm::scale(_ModelMatrix, _scale);
-}
-
-void Mesh::init(bool simple)
-{
-	//generate VAO and bind it
-	glCreateVertexArrays(1, &_VAO);
-	glBindVertexArray(_VAO);
-
-	//generate VBO and bind it and send data
-	glGenBuffers(1, &_VBO);
-	glBindBuffer(GL_ARRAY_BUFFER, _VBO);
-
-	if (_simplify)
-		glBufferData(GL_ARRAY_BUFFER, _simpleVertices.size() * sizeof(SimpleVertex), _simpleVertices.data(), GL_STATIC_DRAW);
-	else
-		glBufferData(GL_ARRAY_BUFFER, _vertices.size() * sizeof(Vertex), _vertices.data(), GL_STATIC_DRAW);
-	
-	//generate EBO and bind it and send data
-	glGenBuffers(1, &_EBO);
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _EBO);
-
-	if (_simplify)
-		glBufferData(GL_ELEMENT_ARRAY_BUFFER, _simpleIndices.size() * sizeof(GLuint), _simpleIndices.data(), GL_STATIC_DRAW);
-	else
-		glBufferData(GL_ELEMENT_ARRAY_BUFFER, _indices.size() * sizeof(GLuint), _indices.data(), GL_STATIC_DRAW);
-		
-	//set vertex attribute pointers and enable them (input assembly)
-	//	position
-	if (_simplify)
-		glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(SimpleVertex), (GLvoid*)offsetof(SimpleVertex, _position));
-	else
-		glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (GLvoid*)offsetof(Vertex, _position));
-	glEnableVertexAttribArray(0);
-	if (!simple)
-	{
-		//	color
-		glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (GLvoid*)offsetof(Vertex, _color));
-		glEnableVertexAttribArray(1);
-		//	texcoord
-		glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (GLvoid*)offsetof(Vertex, _texcoord));
-		glEnableVertexAttribArray(2);
-		//	normal
-		glVertexAttribPointer(3, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (GLvoid*)offsetof(Vertex, _normal));
-		glEnableVertexAttribArray(3);
-	}
-
-	//free
-	glBindVertexArray(0);
-}
-
-//constructors
-Mesh::Mesh
-(
-	ObjLoader objLoader,
-	GLuint type,
-	GLdouble percentage,
-	glm::vec3 position,
-	glm::vec3 origin,
-	glm::vec3 rotation,
-	glm::vec3 scale,
-	bool simple,
-	bool simplify
-) : _type(type), _position(position), _origin(origin), _rotation(rotation), _scale(scale), _simple(simple), _simplify(simplify)
-{
-	_vertices = objLoader.getVertices();
-	_simpleVertices = objLoader.getSimpleVertices();
-
-	if (simplify)
-	{
-		_faces = objLoader.getFaces();
-
-		auto startTime = std::chrono::high_resolution_clock::now();
-
-		simplifyMesh(percentage);
-
-		//size_t i = 0;
-		for (auto f : _faces)
-		{
-			for (auto v : f._vertices)
-			{
-				_simpleIndices.push_back(findVertexPosition(v));
-			}
-			//++i;
-			//if (!(i % 1000))
-			//{
-				//std::cout << ">building simple mesh:	" << 100.f * i / _faces.size() << "%" << std::endl;
-			//}
-		}
-		//std::cout << std::endl;
-		_simplifyTime = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - startTime).count();
-	}
-	else
-		_indices = objLoader.getIndices();
-
-	init(_simple);
-	updateModelMatrix();
-}
-
-Mesh::Mesh(const Mesh* mesh, glm::vec3 position, glm::vec3 rotation, glm::vec3 scale)
-	: _position(position), _rotation(rotation), _scale(scale), _origin(glm::vec3(.0f)),
-	_type(mesh->_type),
-	_simpleVertices(mesh->_simpleVertices), _simpleIndices(mesh->_simpleIndices),
-	_faces(mesh->_faces), _pairs(mesh->_pairs)
-{
-
-	_simplify = true;
-	_simple = true;
-
-	auto startTime = std::chrono::high_resolution_clock::now();
-
-	incrementalRemeshing();
-
-	_simpleIndices.clear();
-	for (auto f : _faces)
-		for (auto v : f._vertices)
-			_simpleIndices.push_back(findVertexPosition(v));
-
-	_aeapTime = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - startTime).count();
-
-	init(_simple);
-	updateModelMatrix();
-}
-
-//destructor
-Mesh::~Mesh()
-{
-	glDeleteVertexArrays(1, &_VAO);
-	glDeleteBuffers(1, &_VBO);
-
-	glDeleteBuffers(1, &_EBO);
-}
-
-//public functions
-void Mesh::render(Shader* shader, int polygonMode)
-{
-	//update uniforms
-	updateModelMatrix();
-	updateUniforms(shader);
-
-	shader->use();
-
-	//bind VAO
-	glBindVertexArray(_VAO);
-
-	//_simple ? glPolygonMode(GL_FRONT_AND_BACK, GL_LINE) : glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
-	glPolygonMode(GL_FRONT_AND_BACK, polygonMode);
-
-	_simplify ? glDrawElements(_type, _simpleIndices.size(), GL_UNSIGNED_INT, 0) : glDrawElements(_type, _indices.size(), GL_UNSIGNED_INT, 0);
-
-	//cleanup
-	glBindVertexArray(0);
-	glUseProgram(0);
-	glActiveTexture(0);
-	glBindTexture(GL_TEXTURE_2D, 0);
-}
-
-void Mesh::computeInitialQuad(SimpleVertex& v)
-{
-	std::vector<Face> faces;
-	for (auto f : _faces)
-	{
-		if (f._vertices[0] == v._id || f._vertices[1] == v._id || f._vertices[2] == v._id)
-			faces.push_back(f);
-	}
-
-	glm::vec3 e1;
-	glm::vec3 e2;
-	glm::vec3 normal;
-	glm::vec4 plane;
-	glm::mat4 quad(.0f);
-	for (auto f : faces)
-	{
-		//e1 = _simpleVertices[findVertexPosition(f._vertices[1])]._position - _simpleVertices[findVertexPosition(f._vertices[0])]._position;
-		//e2 = _simpleVertices[findVertexPosition(f._vertices[2])]._position - _simpleVertices[findVertexPosition(f._vertices[0])]._position;
-		e1 = getVertex(f._vertices[1])._position - getVertex(f._vertices[0])._position;
-		e2 = getVertex(f._vertices[2])._position - getVertex(f._vertices[0])._position;
-		normal = glm::cross(e1, e2);
-		plane = { normal, -glm::dot(_simpleVertices[findVertexPosition(v._id)]._position, normal) };
-		quad += glm::outerProduct(plane, plane);
-	}
-
-	v._quad = quad;
-
-	//if (!(v._id % 1000)
-	//{
-	//	std::cout << ">computing quadrics:	" << 100.f * v._id / _simpleVertices.size() << "%" << std::endl;
-	//}
-}
-
-void Mesh::computeInitialCost()
-{
-	for (auto& p : _pairs)
-	{
-		glm::vec3 pTemp = glm::vec3(.0f);
-		glm::mat4 qTemp = glm::mat4(.0f);
-
-		pTemp = getVertex(p._vertices[0])._position + getVertex(p._vertices[1])._position;
-		qTemp = getVertex(p._vertices[0])._quad + getVertex(p._vertices[1])._quad;
-
-		pTemp /= 2.f;
-		glm::vec4 cost = glm::vec4(pTemp.x, pTemp.y, pTemp.z, 1.f);
-		cost = cost * qTemp;
-
-		p._cost = glm::dot(cost, cost);
-	}
-}
-
-void Mesh::computeCost(GLuint vertexId)
-{
-	for (auto& p : _pairs)
-		if (p._vertices[0] == vertexId || p._vertices[1] == vertexId)
-		{
-			glm::vec3 pTemp = glm::vec3(.0f);
-			glm::mat4 qTemp = glm::mat4(.0f);
-
-			pTemp = getVertex(p._vertices[0])._position + getVertex(p._vertices[1])._position;
-			qTemp = getVertex(p._vertices[0])._quad + getVertex(p._vertices[1])._quad;
-
-			pTemp /= 2.f;
-			glm::vec4 cost = glm::vec4(pTemp.x, pTemp.y, pTemp.z, 1.f);
-			cost = cost * qTemp;
-
-			p._cost = glm::dot(cost, cost);
-		}
-}
-
-SimpleVertex& Mesh::getVertex(const GLuint id)
-{
-	for (auto& v : _simpleVertices)
-		if (v._id == id)
-			return v;
-}
-
-Face& Mesh::getFace(const GLuint id)
-{
-	for (auto& f : _faces)
-		if (f._id == id)
-			return f;
-}
-
-GLuint Mesh::findVertexPosition(const GLuint id)
-{
-	for (size_t i = 0; i < _simpleVertices.size(); ++i)
-		if (_simpleVertices[i]._id == id) return i;
-}
-GLuint Mesh::findFacePosition(const GLuint id)
-{
-	for (size_t i = 0; i < _faces.size(); ++i)
-		if (_faces[i]._id == id) return i;
-}
-GLuint Mesh::findPairPosition(const GLuint id)
-{
-	for (size_t i = 0; i < _pairs.size(); ++i)
-		if (_pairs[i]._id == id) return i;
-}
-
-bool Mesh::contains(GLuint faceId, GLuint vertexId)
-{
-	if
-	(
-		getFace(faceId)._vertices[0] == vertexId ||
-		getFace(faceId)._vertices[1] == vertexId ||
-		getFace(faceId)._vertices[2] == vertexId
-	) return true;
-	return false;
-}
-
-void Mesh::collapse(GLuint newId, GLuint oldId)
-{
-	glm::vec3 newPosition = (getVertex(newId)._position + getVertex(oldId)._position) / 2.f;
-	glm::mat4 newQuad = getVertex(newId)._quad + getVertex(oldId)._quad;
-
-	std::set<GLuint> newNeighbors;
-	for (auto& n : getVertex(newId)._neighbors)
-		newNeighbors.insert(n);
-	for (auto& n : getVertex(oldId)._neighbors)
-		newNeighbors.insert(n);
-
-	newNeighbors.erase(oldId);
-	newNeighbors.erase(newId);
-
-	getVertex(newId)._position = newPosition;
-	getVertex(newId)._neighbors = newNeighbors;
-	getVertex(newId)._quad = newQuad;
-
-	//	update neighbors
-	for (auto& n : getVertex(newId)._neighbors)
-	{
-		getVertex(n)._neighbors.erase(oldId);
-		getVertex(n)._neighbors.insert(newId);
-	}
-
-	//update faces
-	//	select faces to be removed
-	std::vector<GLuint> faces;
-	for (auto& f : getVertex(newId)._faces)
-		if (contains(f, oldId))
-			faces.push_back(f);
-
-	//	insert v2's faces ids to v1
-	for (auto& f : getVertex(oldId)._faces)
-		getVertex(newId)._faces.insert(f);
-
-	//remove ereased faces from new vertex
-	for (auto f : faces)
-		getVertex(newId)._faces.erase(f);
-
-	//	remove oldId from all faces
-	for (auto& f : getVertex(newId)._faces)
-		for (size_t i = 0; i < 3; ++i)
-			if (getFace(f)._vertices[i] == oldId)
-				getFace(f)._vertices[i] = newId;
-
-	//remove deleted faces ids from all neighbors
-	for (auto& n : getVertex(newId)._neighbors)
-		for (auto f : faces)
-			getVertex(n)._faces.erase(f);
-
-	//update pairs
-	//	delete pairs
-	for (size_t i = 0; i < _pairs.size(); ++i)
-		if (_pairs[i]._vertices[0] == newId || _pairs[i]._vertices[1] == newId || _pairs[i]._vertices[0] == oldId || _pairs[i]._vertices[1] == oldId)
-		{
-			_pairs.erase(_pairs.begin() + i);
-			--i;
-		}
-	//	add new pairs
-	for (auto n : getVertex(newId)._neighbors)
-		_pairs.push_back(Pair(newId, n));
-
-	for (auto f : faces)
-		_faces.erase(_faces.begin() + findFacePosition(f));
-
-	//	delete vertex
-	_simpleVertices.erase(_simpleVertices.begin() + findVertexPosition(oldId));
-}
-
-
-void Mesh::simplifyMesh(GLdouble percentage)
-{
-	//compute number of iterations
-	size_t maxIt;
-	if (percentage == 0.0)
-		maxIt = _simpleVertices.size() - 1;
-	else
-		maxIt = static_cast<size_t>((1.0 - percentage) * _simpleVertices.size());
-
-	//compute the Q matrices for all vertices
-	for (auto& v : _simpleVertices)
-		computeInitialQuad(v);
-
-	//select all valid pairs
-	//	set neighbors of all vertices
-	for (auto f : _faces)
-	{
-		getVertex(f._vertices[0])._neighbors.insert(f._vertices[1]);
-		getVertex(f._vertices[0])._neighbors.insert(f._vertices[2]);
-
-		getVertex(f._vertices[1])._neighbors.insert(f._vertices[0]);
-		getVertex(f._vertices[1])._neighbors.insert(f._vertices[2]);
-
-		getVertex(f._vertices[2])._neighbors.insert(f._vertices[0]);
-		getVertex(f._vertices[2])._neighbors.insert(f._vertices[1]);
-	}
-
-	//	update pairs
-	for (size_t i = 0; i < _simpleVertices.size(); ++i)
-	{
-		for (auto& n : _simpleVertices[findVertexPosition(i)]._neighbors)
-			_pairsSet.insert(Pair(_simpleVertices[findVertexPosition(i)]._id, n));
-	}
-	for (auto& p : _pairsSet)
-	{
-		_pairs.push_back(p);
-	}
-	_pairsSet.clear();
-
-	for (int i = 0; i < _pairs.size(); ++i)
-		_pairs[i]._id = i;
-
-	//compute the optimal contraction target for each valid pair; the error of this target vertex becomes the cost of contracting that pair
-	computeInitialCost();
-
-	for (size_t i = 0; i < maxIt; ++i)
-	{
-		//std::cout << ">iteration: " << i + 1 << "/" << maxIt << std::endl;
-
-		//find the index of the pair with the lowest cost
-		GLfloat lowestCost = _pairs[0]._cost;
-		GLuint lowestCostIdx;
-		for (size_t i = 0; i < _pairs.size(); ++i)
-		{
-			if (_pairs[i]._cost <= lowestCost)
-			{
-				lowestCostIdx = i;
-				lowestCost = _pairs[i]._cost;
-			}
-		}
-
-		//iteratively remove the pair (v1, v2) of lest cost, contract this pair, and update the costs of all valid pairs involving v
-		//	create a new simple vertex
-		GLuint newId = _pairs[lowestCostIdx]._vertices[0];
-		GLuint oldId = _pairs[lowestCostIdx]._vertices[1];
-
-		collapse(newId, oldId);
-
-		//compute the optimal contraction target for each valid pair; the error of this target vertex becomes the cost of contracting that pair
-		computeCost(newId);
-	}
-}
-/*
-std::array<std::array<GLdouble, 3>, 3> transpose(std::array<std::array<GLdouble, 3>, 3> matrix)
-{
-	return
-	{{
-		{matrix[0][0], matrix[1][0], matrix[2][0]},
-		{matrix[0][1], matrix[1][1], matrix[2][1]},
-		{matrix[0][2], matrix[1][2], matrix[2][2]}
-	}};
-}
-
-GLdouble det(GLdouble a, GLdouble b, GLdouble c, GLdouble d)
-{
-	return a * d - b * c;
-}
-
-std::array<std::array<GLdouble, 3>, 3> inverse(std::array<std::array<GLdouble, 3>, 3> matrix)
-{
-	GLdouble det0 = matrix[0][0] * det(matrix[1][1], matrix[1][2], matrix[2][1], matrix[2][2]) - matrix[0][1] * det(matrix[1][0], matrix[1][2], matrix[2][0], matrix[2][2]) + matrix[0][2] * det(matrix[1][0], matrix[1][1], matrix[2][0], matrix[2][1]);
-	matrix = transpose(matrix);
-
-	return
-	{{
-		{
-			det(matrix[1][1], matrix[1][2], matrix[2][1], matrix[2][2]) / det0,
-			-det(matrix[1][0], matrix[1][2], matrix[2][0], matrix[2][2]) / det0,
-			det(matrix[1][0], matrix[1][1], matrix[2][0], matrix[2][1]) / det0
-		},
-		{
-			-det(matrix[0][1], matrix[0][2], matrix[2][1], matrix[2][2]) / det0,
-			det(matrix[0][0], matrix[0][2], matrix[2][0], matrix[2][2]) / det0,
-			-det(matrix[0][0], matrix[0][1], matrix[2][0], matrix[2][1]) / det0
-		},
-		{
-			det(matrix[0][1], matrix[0][2], matrix[1][1], matrix[1][2]) / det0,
-			-det(matrix[0][0], matrix[0][2], matrix[1][0], matrix[1][2]) / det0,
-			det(matrix[0][0], matrix[0][1], matrix[1][0], matrix[1][1]) / det0
-		}
-	}};
-}
-
-std::array<std::array<GLdouble, 3>, 3> sum(std::array<std::array<GLdouble, 3>, 3> matrix1, std::array<std::array<GLdouble, 3>, 3> matrix2)
-{
-	std::array<std::array<GLdouble, 3>, 3> result;
-
-	for (int i = 0; i < 3; ++i)
-		for (int j = 0; j < 3; ++j)
-			result[i][j] = matrix1[i][j] + matrix2[i][j];
-
-	return result;
-}
-
-std::array<std::array<GLdouble, 3>, 3> multiply(std::array<std::array<GLdouble, 3>, 3> matrix1, std::array<std::array<GLdouble, 3>, 3> matrix2)
-{
-	std::array<std::array<GLdouble, 3>, 3> result;
-
-	for (int i = 0; i < 3; ++i)
-		for (int j = 0; j < 3; ++j)
-		{
-			result[i][j] = 0;
-			for (int k = 0; k < 3; ++k)
-				result[i][j] += matrix1[i][k] * matrix2[k][j];
-		}
-
-	return result;
-}
-
-std::array<std::array<GLdouble, 3>, 3> divide(std::array<std::array<GLdouble, 3>, 3> matrix, GLdouble scalar)
-{
-	for (int i = 0; i < 3; ++i)
-		for (int j = 0; j < 3; ++j)
-			matrix[i][j] /= scalar;
-	return matrix;
-}
-
-std::array<std::array<GLdouble, 3>, 3> pseudoInverse(std::array<std::array<GLdouble, 3>, 3> matrix)
-{
-	return multiply(inverse(multiply(transpose(matrix), matrix)), transpose(matrix));
-}
-
-std::array<std::array<GLdouble, 3>, 3> findTransformationMatrix(std::array<std::array<GLdouble, 3>, 3> triangle, std::array<std::array<GLdouble, 3>, 3> invUnit)
-{
-	return multiply(triangle, invUnit);
-}
-
-std::array<std::array<GLdouble, 3>, 3> getRotationMatrix(std::array<std::array<GLdouble, 3>, 3> matrix)
-{
-	Eigen::Matrix<double, 3, 3> T
-	{
-		{matrix[0][0], matrix[0][1], matrix[0][2]},
-		{matrix[1][0], matrix[1][1], matrix[1][2]},
-		{matrix[2][0], matrix[2][1], matrix[2][2]}
-	};
-
-	Eigen::BDCSVD<Eigen::Matrix<double, 3, 3>> svd(T, Eigen::ComputeFullU | Eigen::ComputeFullV);
-
-	auto U = svd.matrixU();
-	auto V = svd.matrixV();
-
-	auto R = U * (V.transpose());
-
-	for (int i = 0; i < 3; ++i)
-		for (int j = 0; j < 3; ++j)
-			matrix[i][j] = R(i, j);
-
-	return matrix;
-}
-
-GLdouble area(std::array<std::array<GLdouble, 3>, 3> triangle)
-{
-	GLdouble a, b, c;
-	a = sqrt(pow(triangle[0][1] - triangle[0][0], 2.0) + pow(triangle[1][1] - triangle[1][0], 2.0) + pow(triangle[2][1] - triangle[2][0], 2.0));
-	b = sqrt(pow(triangle[0][2] - triangle[0][0], 2.0) + pow(triangle[1][2] - triangle[1][0], 2.0) + pow(triangle[2][2] - triangle[2][0], 2.0));
-	c = sqrt(pow(triangle[0][2] - triangle[0][1], 2.0) + pow(triangle[1][2] - triangle[1][1], 2.0) + pow(triangle[2][2] - triangle[2][1], 2.0));
-
-	GLdouble s = (a + b + c) / 2.0;
-	return sqrt(s * (s - a) * (s - b) * (s - c));
-}
-
-GLdouble calculateScale(std::array<std::array<GLdouble, 3>, 3> triangle)
-{
-	GLdouble unitArea = sqrt(3.0) / 4.0;
-
-	return sqrt(area(triangle) / unitArea);
-}
-
-void Mesh::aeap()
-{
-	std::array<std::array<GLdouble, 3>, 3> unit = { {{-0.5 + 1.0, 0.0 + 1.0, 0.0 + 1.0}, {0.5 + 1.0, 0.0 + 1.0, 0.0 + 1.0}, {0.0 + 1.0, 0.0 + 1.0, sqrt(3.0) / 2.0 + 1.0}} };
-	std::array<std::array<GLdouble, 3>, 3> invUnit = pseudoInverse(unit);
-
-	std::array<std::array<GLdouble, 3>, 3> equilateral;
-	std::vector<std::array<std::array<GLdouble, 3>, 3>> newTriangles;
-
-	std::array<std::array<GLdouble, 3>, 3> triangle;
-	std::array<std::array<GLdouble, 3>, 3> R;
-	std::vector<std::array<std::array<GLdouble, 3>, 3>> L;
-
-	GLdouble s;
-
-	//local step
-	for (auto& f : _faces)
-	{
-		triangle = 
-		{ {
-		{getVertex(f._vertices[0])._position.x, getVertex(f._vertices[1])._position.x, getVertex(f._vertices[2])._position.x},
-		{getVertex(f._vertices[0])._position.y, getVertex(f._vertices[1])._position.y, getVertex(f._vertices[2])._position.y},
-		{getVertex(f._vertices[0])._position.z, getVertex(f._vertices[1])._position.z, getVertex(f._vertices[2])._position.z}
-		} };
-
-		R = getRotationMatrix(findTransformationMatrix(triangle, invUnit));
-		s = calculateScale(triangle);
-		for (int i = 0; i < 3; ++i)
-			for (int j = 0; j < 3; ++j)
-				R[i][j] *= s;
-		equilateral = multiply(R, unit);
-		L.push_back(multiply(equilateral, pseudoInverse(triangle)));
-	}
-
-	//global step
-	int i = 0;
-	for (auto& f : _faces)
-	{
-		triangle =
-		{ {
-		{getVertex(f._vertices[0])._position.x, getVertex(f._vertices[1])._position.x, getVertex(f._vertices[2])._position.x},
-		{getVertex(f._vertices[0])._position.y, getVertex(f._vertices[1])._position.y, getVertex(f._vertices[2])._position.y},
-		{getVertex(f._vertices[0])._position.z, getVertex(f._vertices[1])._position.z, getVertex(f._vertices[2])._position.z}
-		} };
-
-		newTriangles.push_back(multiply((divide(sum(L[i], transpose(L[i])), area(triangle) / 2.0)), pseudoInverse(multiply(transpose(triangle), transpose(pseudoInverse(triangle))))));
-		++i;
-	}
-
-
-	i = 0;
-	for (auto& f : _faces)
-	{
-		getVertex(f._vertices[0])._position.x = newTriangles[i][0][0];
-		getVertex(f._vertices[0])._position.y = newTriangles[i][0][1];
-		getVertex(f._vertices[0])._position.z = newTriangles[i][0][2];
-
-		getVertex(f._vertices[1])._position.x = newTriangles[i][1][0];
-		getVertex(f._vertices[1])._position.y = newTriangles[i][1][1];
-		getVertex(f._vertices[1])._position.z = newTriangles[i][1][2];
-
-		getVertex(f._vertices[2])._position.x = newTriangles[i][2][0];
-		getVertex(f._vertices[2])._position.y = newTriangles[i][2][1];
-		getVertex(f._vertices[2])._position.z = newTriangles[i][2][2];
-		++i;
-	}
-
-}
-*/
-
-GLdouble calculateLength(GLdouble x, GLdouble y, GLdouble z)
-{
-	return sqrt(pow(x, 2.0) + pow(y, 2.0) + pow(z, 2.0));
-}
-
-void Mesh::split(Pair& pair)
-{
-	SimpleVertex e1 = getVertex(pair._vertices[0]);
-	SimpleVertex e2 = getVertex(pair._vertices[1]);
-
-	//get faces
-	std::vector<GLuint> faces;
-	for (auto& f : e1._faces)
-	{
-		if (contains(f, e2._id))
-			faces.push_back(f);
-	}
-	//std::cout << faces.size() << "\t";
-
-	//other vertices
-	std::vector<GLuint> v;
-	for (int i = 0; i < faces.size(); ++i)
-		for (int j = 0; j < 3; ++j)
-			if (getFace(faces[i])._vertices[j] != e1._id && getFace(faces[i])._vertices[j] != e2._id)
-				v.push_back(getFace(faces[i])._vertices[j]);
-
-	//std::cout << v.size() << "\t";
-
-	if (v.size() == faces.size() && v.size() == 2)
-	{
-		//add new vertex
-		glm::vec3 newPosition = (e1._position + e2._position) / 2.f;
-		GLuint newId = _simpleVertices[_simpleVertices.size() - 1]._id + 1;
-
-		_simpleVertices.push_back(SimpleVertex(newId, newPosition));
-
-		//remove old faces from e2
-		for (auto f : faces)
-			e2._faces.erase(f);
-
-		//change starting faces' vertrices
-		for (int i = 0; i < faces.size(); ++i)
-		{
-			getFace(faces[i])._vertices[0] = e1._id;
-			getFace(faces[i])._vertices[1] = v[i];
-			getFace(faces[i])._vertices[2] = newId;
-			getFace(faces[i]).sortVertices();
-		}
-
-		//add neighbors to new Vertex
-		getVertex(newId)._neighbors.insert(e1._id);
-		getVertex(newId)._neighbors.insert(e2._id);
-		for (auto v_ : v)
-			getVertex(newId)._neighbors.insert(v_);
-
-		//remove neighbors from pair
-		e1._neighbors.erase(e2._id);
-		e2._neighbors.erase(e1._id);
-
-		//add new vertex to other vertices' neighbors
-		e1._neighbors.insert(newId);
-		e2._neighbors.insert(newId);
-		for (auto v_ : v)
-			getVertex(v_)._neighbors.insert(newId);
-
-		GLuint newFaceId;
-		//add faces
-		for (auto v_ : v)
-		{
-			newFaceId = _faces[_faces.size() - 1]._id + 1;
-			_faces.push_back(Face(newFaceId, { {e2._id, v_, newId} }));
-		}
-
-		//add new faces to vertices
-		for (int i = 0; i < v.size(); ++i)
-		{
-			e2._faces.insert(_faces[_faces.size() - 1]._id - i);
-			getVertex(v[i])._faces.insert(_faces[_faces.size() - 1]._id - i);
-			getVertex(newId)._faces.insert(_faces[_faces.size() - 1]._id - i);
-		}
-		for (auto f : faces)
-			getVertex(newId)._faces.insert(f);
-
-		//update pairs
-		//	add new pairs
-		for (auto v_ : v)
-		{
-			_pairs.push_back(Pair(newId, v_));
-			_pairs[_pairs.size() - 1]._id = _pairs[_pairs.size() - 2]._id + 1;
-		}
-		_pairs.push_back(Pair(newId, e2._id));
-		_pairs[_pairs.size() - 1]._id = _pairs[_pairs.size() - 2]._id + 1;
-		//	change the starging pair
-		pair.set(e1._id, newId);
-	}
-	else
-		_pairs.erase(_pairs.begin() + findPairPosition(pair._id));
-}
-
-void Mesh::flip(Pair& pair)
-{
-	SimpleVertex e1 = getVertex(pair._vertices[0]);
-	SimpleVertex e2 = getVertex(pair._vertices[1]);
-
-	int deviation1, deviation2;
-	GLuint newFaceId;
-
-	//get faces
-	std::vector<GLuint> faces;
-	for (auto& f : e1._faces)
-	{
-		if (contains(f, e2._id))
-			faces.push_back(f);
-	}
-	//std::cout << faces.size() << "\t";
-
-	//other vertices
-	std::vector<GLuint> v;
-	for (int i = 0; i < faces.size(); ++i)
-		for (int j = 0; j < 3; ++j)
-			if (getFace(faces[i])._vertices[j] != e1._id && getFace(faces[i])._vertices[j] != e2._id)
-				v.push_back(getFace(faces[i])._vertices[j]);
-
-	if (v.size() == 2 && v.size() == faces.size())
-	{
-		deviation1 =
-			abs(static_cast<int>(e1._neighbors.size() - 6)) +
-			abs(static_cast<int>(e2._neighbors.size() - 6)) +
-			abs(static_cast<int>(getVertex(v[0])._neighbors.size() - 4)) +
-			abs(static_cast<int>(getVertex(v[1])._neighbors.size() - 4));
-
-		deviation2 =
-			abs(static_cast<int>(getVertex(v[0])._neighbors.size() - 6)) +
-			abs(static_cast<int>(getVertex(v[1])._neighbors.size() - 6)) +
-			abs(static_cast<int>(e2._neighbors.size() - 4)) +
-			abs(static_cast<int>(e1._neighbors.size() - 4));
-
-		if (deviation2 - deviation1 < 0)
-		{
-			//remove faces from vertices
-			e1._faces.erase(faces[1]);
-			e2._faces.erase(faces[0]);
-
-			//update neighbors
-			getVertex(v[0])._neighbors.insert(v[1]);
-			getVertex(v[1])._neighbors.insert(v[0]);
-			getVertex(e1._id)._neighbors.erase(e2._id);
-			getVertex(e2._id)._neighbors.erase(e1._id);
-
-			//change pair
-			pair.set(v[0], v[1]);
-
-			//update faces and add them to vertices
-			getFace(faces[0])._vertices[0] = v[0];
-			getFace(faces[0])._vertices[1] = v[1];
-			getFace(faces[0])._vertices[2] = e1._id;
-			getVertex(v[1])._faces.insert(faces[0]);
-			getFace(faces[0]).sortVertices();
-
-			getFace(faces[1])._vertices[0] = v[0];
-			getFace(faces[1])._vertices[1] = v[1];
-			getFace(faces[1])._vertices[2] = e2._id;
-			getVertex(v[0])._faces.insert(faces[1]);
-			getFace(faces[1]).sortVertices();
-		}
-	}
-
-}
-
-void Mesh::vertexRelocation(SimpleVertex& vertex)
-{
-	glm::vec3 avg(0.f);
-
-	for (auto n : vertex._neighbors)
-	{
-		avg += getVertex(n)._position;
-	}
-
-	avg /= vertex._neighbors.size();
-	vertex._position = avg;
-}
-
-void Mesh::incrementalRemeshing()
-{
-	//get target edge length (in this case average length of all pairs)
-	GLdouble L = 0.0;
-	for (auto& p : _pairs)
-		L += calculateLength
-		(
-			getVertex(p._vertices[0])._position[0] -
-			getVertex(p._vertices[1])._position[0],
-			getVertex(p._vertices[0])._position[1] -
-			getVertex(p._vertices[1])._position[1],
-			getVertex(p._vertices[0])._position[2] -
-			getVertex(p._vertices[1])._position[2]
-		);
-	L /= _pairs.size();
-
-	GLdouble L_max = 4.0 * L / 3.0;
-	GLdouble L_min = 4.0 * L / 5.0;
-
-	//collapse edges shorter than L_min
-	for (int i = 0; i < _pairs.size(); ++i)
-	{
-		if
-		(
-			calculateLength
-			(
-				getVertex(_pairs[i]._vertices[0])._position[0] -
-				getVertex(_pairs[i]._vertices[1])._position[0],
-				getVertex(_pairs[i]._vertices[0])._position[1] -
-				getVertex(_pairs[i]._vertices[1])._position[1],
-				getVertex(_pairs[i]._vertices[0])._position[2] -
-				getVertex(_pairs[i]._vertices[1])._position[2]
-			) < L_min
-		)
-		collapse(_pairs[i]._vertices[0], _pairs[i]._vertices[1]);
-	}
-
-	//split edges longer than L_max
-	for (int i = _pairs.size() - 1; i >= 0; --i)
-	{
-		if
-		(
-			calculateLength
-			(
-				getVertex(_pairs[i]._vertices[0])._position[0] -
-				getVertex(_pairs[i]._vertices[1])._position[0],
-				getVertex(_pairs[i]._vertices[0])._position[1] -
-				getVertex(_pairs[i]._vertices[1])._position[1],
-				getVertex(_pairs[i]._vertices[0])._position[2] -
-				getVertex(_pairs[i]._vertices[1])._position[2]
-			) > L_max
-		)
-		split(_pairs[i]);
-	}
-
-	//flip edges (failed)
-	//for (int i = _pairs.size() - 1; i >= 0; --i)
-	//	flip(_pairs[i]);
-
-	//vertex relocation
-	for (auto& v : _simpleVertices)
-		vertexRelocation(v);
+#include "../include/mesh.h"
+
+//private functions
+std::function<void(Mesh*)> Mesh::_preview;
+
+void Mesh::updateModelMatrix()
+{
+	_ModelMatrix = glm::mat4(1.f);
+	_ModelMatrix = glm::translate(_ModelMatrix, _origin);
+	_ModelMatrix = glm::rotate(_ModelMatrix, glm::radians(_rotation.x), glm::vec3(1.f, .0f, .0f));
+	_ModelMatrix = glm::rotate(_ModelMatrix, glm::radians(_rotation.y), glm::vec3(.0f, 1.f, .0f));
+	_ModelMatrix = glm::rotate(_ModelMatrix, glm::radians(_rotation.z), glm::vec3(.0f, .0f, 1.f));
+	_ModelMatrix = glm::translate(_ModelMatrix, _position - _origin);
+	_ModelMatrix = glm::scale(_ModelMatrix, _scale);
+}
+
+void Mesh::init(bool simple)
+{
+	//generate VAO and bind it
+	glCreateVertexArrays(1, &_VAO);
+	glBindVertexArray(_VAO);
+
+	//generate VBO and bind it and send data
+	glGenBuffers(1, &_VBO);
+	glBindBuffer(GL_ARRAY_BUFFER, _VBO);
+
+	std::vector<GLuint> indices;
+	std::vector<GLuint> remap;
+	PackedVertices packed = exportGeometry(simple, indices, &remap);
+	if (_type == GL_TRIANGLES)
+	{
+		_cacheBefore = simulateVertexCache(_simplify ? _simpleIndices : _indices, packed.size());
+		_cacheAfter = simulateVertexCache(indices, packed.size());
+	}
+	initClusters(simple, indices, remap);
+
+	_vertexBufferBytes = packed.bytes();
+	_dequantization = packed._dequantization;
+	_quantizationError = packed._error;
+	glBufferData(GL_ARRAY_BUFFER, packed.bytes(), packed._data.data(), GL_STATIC_DRAW);
+	
+	//generate EBO and bind it and send data
+	glGenBuffers(1, &_EBO);
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _EBO);
+	PackedIndices packedIndices = PackedIndices::pack(indices, packed.size());
+	_indexType = packedIndices._type;
+	_indexBufferBytes = packedIndices.bytes();
+	_compressedIndexBytes = encodeIndices(indices).size();
+	glBufferData(GL_ELEMENT_ARRAY_BUFFER, packedIndices.bytes(), packedIndices._data.data(), GL_STATIC_DRAW);
+	
+
+	//set vertex attribute pointers and enable them (input assembly)
+	packed.setAttributePointers();
+
+	//free
+	glBindVertexArray(0);
+}
+
+void Mesh::initClusters(bool simple, const std::vector<GLuint>& indices, const std::vector<GLuint>& remap)
+{
+	//positions and normals in the order of the uploaded vertices
+	size_t count = _simplify ? _simpleVertices.size() : _vertices.size();
+	std::vector<glm::vec3> positions(count);
+	std::vector<glm::vec3> normals;
+	for (size_t i = 0; i < count; ++i)
+		positions[remap.empty() ? i : remap[i]] = _simplify ? _simpleVertices[i]._position : _vertices[i]._position;
+
+	//normals orient the cones of shaded meshes, wireframes draw hidden lines and are culled by the frustum only
+	if (!_simplify && !simple)
+	{
+		normals.resize(count);
+		for (size_t i = 0; i < count; ++i)
+			normals[remap.empty() ? i : remap[i]] = _vertices[i]._normal;
+	}
+
+	_bounds = boundingSphere(positions, indices, 0, indices.size());
+	_clusters.clear();
+	if (_type == GL_TRIANGLES)
+		_clusters = buildClusters(positions, normals, indices);
+}
+
+PackedVertices Mesh::exportGeometry(bool simple, std::vector<GLuint>& indices, std::vector<GLuint>* remap) const
+{
+	//wireframe meshes need positions only, SimpleVertex would also upload IDs, quadrics and pointers of rings
+	PackedVertices packed = _simplify ?
+		PackedVertices::positions(_simpleVertices) :
+		simple ? PackedVertices::positions(_vertices) : PackedVertices::attributes(_vertices, QUANTIZE_ATTRIBUTES);
+
+	//triangle order after collapses is close to random, the GPU copy is reordered (members keep their order)
+	indices = _simplify ? _simpleIndices : _indices;
+	if (_type == GL_TRIANGLES)
+	{
+		optimizeVertexCache(indices, packed.size());
+		std::vector<GLuint> fetch = optimizeVertexFetch(indices, packed.size());
+		packed.reorder(fetch);
+		if (remap)
+			remap->swap(fetch);
+	}
+	return packed;
+}
+
+bool Mesh::exportIndices(const char* fileName) const
+{
+	std::vector<GLuint> indices;
+	exportGeometry(_simple, indices);
+
+	//the file is read back, so a broken encoding is reported right away
+	std::vector<GLuint> loaded;
+	return saveIndices(fileName, indices) && loadIndices(fileName, loaded) && loaded == indices;
+}
+
+void Mesh::streamUpload()
+{
+	//positions only, like other simple meshes; triangles are written straight into the mapped storage
+	glm::vec3* positions = static_cast<glm::vec3*>(_streamVertices.map(_simpleVertices.size() * sizeof(glm::vec3)));
+	GLuint* indices = static_cast<GLuint*>(_streamIndices.map(3 * _faces.size() * sizeof(GLuint)));
+	parallelFor(0, _simpleVertices.size(), [&](size_t i) { positions[i] = _simpleVertices[i]._position; });
+	parallelFor(0, _faces.size(), [&](size_t f)
+	{
+		for (size_t k = 0; k < 3; ++k)
+			indices[3 * f + k] = findVertexPosition(_faces[f]._vertices[k]);
+	});
+	_streamCount = static_cast<GLsizei>(3 * _faces.size());
+
+	if (!_streamVAO)
+	{
+		glCreateVertexArrays(1, &_streamVAO);
+		glEnableVertexArrayAttrib(_streamVAO, 0);
+		glVertexArrayAttribFormat(_streamVAO, 0, 3, GL_FLOAT, GL_FALSE, 0);
+		glVertexArrayAttribBinding(_streamVAO, 0, 0);
+	}
+
+	//buffers change only when they grow, offsets change every upload
+	glVertexArrayVertexBuffer(_streamVAO, 0, _streamVertices.buffer(), _streamVertices.offset(), sizeof(glm::vec3));
+	glVertexArrayElementBuffer(_streamVAO, _streamIndices.buffer());
+}
+
+void Mesh::preview()
+{
+	if (!_preview)
+		return;
+
+	auto now = std::chrono::steady_clock::now();
+	if (now - _lastPreview < std::chrono::duration<double>(PREVIEW_INTERVAL))
+		return;
+
+	updateModelMatrix();
+	streamUpload();
+	_preview(this);
+	_lastPreview = std::chrono::steady_clock::now();
+}
+
+void Mesh::releaseStream()
+{
+	_streamVertices.release();
+	_streamIndices.release();
+	if (_streamVAO)
+		glDeleteVertexArrays(1, &_streamVAO);
+	_streamVAO = 0;
+	_streamCount = 0;
+}
+
+//constructors
+Mesh::Mesh
+(
+	ObjLoader objLoader,
+	GLuint type,
+	SimplifyTarget target,
+	glm::vec3 position,
+	glm::vec3 origin,
+	glm::vec3 rotation,
+	glm::vec3 scale,
+	bool simple,
+	bool simplify
+) : _target(target), _type(type), _position(position), _origin(origin), _rotation(rotation), _scale(scale), _simple(simple), _simplify(simplify)
+{
+	_vertices = objLoader.getVertices();
+	_simpleVertices = objLoader.getSimpleVertices();
+
+	if (simplify)
+	{
+		_faces = objLoader.getFaces();
+		_wedges = objLoader.getWedges();
+
+		//input surface for the deviation measurement
+		std::vector<glm::vec3> inputPositions;
+		std::vector<std::array<GLuint, 3>> inputTriangles;
+		gatherTriangles(inputPositions, inputTriangles);
+
+		auto startTime = std::chrono::high_resolution_clock::now();
+
+		if (_target._mode == CLUSTERING)
+			clusterMesh(_target);
+		else
+			simplifyMesh(_target);
+		releaseStream();
+		buildAttributeBuffers();
+
+		//size_t i = 0;
+		for (auto f : _faces)
+		{
+			for (auto v : f._vertices)
+			{
+				_simpleIndices.push_back(findVertexPosition(v));
+			}
+			//++i;
+			//if (!(i % 1000))
+			//{
+				//std::cout << ">building simple mesh:	" << 100.f * i / _faces.size() << "%" << std::endl;
+			//}
+		}
+		//std::cout << std::endl;
+		_simplifyTime = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - startTime).count();
+
+		std::vector<glm::vec3> positions;
+		std::vector<std::array<GLuint, 3>> triangles;
+		gatherTriangles(positions, triangles);
+		_simplifyDeviation = surfaceDeviation(inputPositions, inputTriangles, positions, triangles);
+	}
+	else
+		_indices = objLoader.getIndices();
+
+	init(_simple);
+	updateModelMatrix();
+}
+
+Mesh::Mesh(const Mesh* mesh, glm::vec3 position, glm::vec3 rotation, glm::vec3 scale, const RemeshTarget& target)
+	: _position(position), _rotation(rotation), _scale(scale), _origin(glm::vec3(.0f)),
+	_type(mesh->_type),
+	_simpleVertices(mesh->_simpleVertices), _simpleIndices(mesh->_simpleIndices),
+	_faces(mesh->_faces), _pairs(mesh->_pairs)
+{
+
+	_simplify = true;
+	_simple = true;
+
+	std::vector<glm::vec3> inputPositions;
+	std::vector<std::array<GLuint, 3>> inputTriangles;
+	gatherTriangles(inputPositions, inputTriangles);
+
+	auto startTime = std::chrono::high_resolution_clock::now();
+
+	incrementalRemeshing(target);
+	releaseStream();
+
+	_simpleIndices.clear();
+	for (auto f : _faces)
+		for (auto v : f._vertices)
+			_simpleIndices.push_back(findVertexPosition(v));
+
+	_aeapTime = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - startTime).count();
+
+	std::vector<glm::vec3> positions;
+	std::vector<std::array<GLuint, 3>> triangles;
+	gatherTriangles(positions, triangles);
+	_remeshDeviation = surfaceDeviation(inputPositions, inputTriangles, positions, triangles);
+
+	init(_simple);
+	updateModelMatrix();
+}
+
+Mesh::Mesh(const Mesh* mesh)
+	: _vertices(mesh->_vertices), _indices(mesh->_indices),
+	_simplifyTime(mesh->_simplifyTime), _simplifyError(mesh->_simplifyError), _simplifyDeviation(mesh->_simplifyDeviation),
+	_position(mesh->_position), _origin(mesh->_origin), _rotation(mesh->_rotation), _scale(mesh->_scale), _type(mesh->_type)
+{
+	_simplify = false;
+	_simple = false;
+
+	init(_simple);
+	updateModelMatrix();
+}
+
+//destructor
+Mesh::~Mesh()
+{
+	glDeleteVertexArrays(1, &_VAO);
+	glDeleteBuffers(1, &_VBO);
+
+	glDeleteBuffers(1, &_EBO);
+
+	releaseStream();
+}
+
+//public functions
+void Mesh::render(Shader* shader, int polygonMode)
+{
+	//update uniforms
+	updateModelMatrix();
+	updateUniforms(shader);
+
+	shader->use();
+
+	//bind VAO
+	glBindVertexArray(_VAO);
+
+	//_simple ? glPolygonMode(GL_FRONT_AND_BACK, GL_LINE) : glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+	glPolygonMode(GL_FRONT_AND_BACK, polygonMode);
+
+	//visible clusters of the last cull, whole mesh otherwise
+	if (_culled)
+		glMultiDrawElements(_type, _drawCounts.data(), _indexType, _drawOffsets.data(), static_cast<GLsizei>(_drawCounts.size()));
+	else
+		_simplify ? glDrawElements(_type, _simpleIndices.size(), _indexType, 0) : glDrawElements(_type, _indices.size(), _indexType, 0);
+	_culled = false;
+
+	//cleanup
+	glBindVertexArray(0);
+	glUseProgram(0);
+	glActiveTexture(0);
+	glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+void Mesh::cull(const glm::mat4& viewProjection, const glm::vec3& camera, int polygonMode)
+{
+	_drawCounts.clear();
+	_drawOffsets.clear();
+	_visibleClusters = 0;
+	_visibleTriangles = 0;
+	_culled = true;
+
+	//clusters are tested in object space, planes of the whole transform and the camera are moved there
+	updateModelMatrix();
+	Frustum frustum(viewProjection * _ModelMatrix);
+	if (!frustum.intersects(_bounds))
+		return;
+	glm::vec3 eye = glm::vec3(glm::inverse(_ModelMatrix) * glm::vec4(camera, 1.f));
+	bool backFaces = polygonMode == GL_FILL;
+
+	size_t indexSize = _indexType == GL_UNSIGNED_SHORT ? sizeof(GLushort) : sizeof(GLuint);
+	GLuint end = std::numeric_limits<GLuint>::max();
+	for (auto& c : _clusters)
+	{
+		if (!frustum.intersects(c._bounds) || (backFaces && c.backFacing(eye)))
+			continue;
+
+		//clusters are consecutive in the index buffer, neighbouring visible ones form one draw
+		if (c._firstIndex == end)
+			_drawCounts.back() += c._count;
+		else
+		{
+			_drawCounts.push_back(c._count);
+			_drawOffsets.push_back(reinterpret_cast<const GLvoid*>(c._firstIndex * indexSize));
+		}
+		end = c._firstIndex + c._count;
+		++_visibleClusters;
+		_visibleTriangles += c._count / 3;
+	}
+}
+
+void Mesh::renderStream(Shader* shader, int polygonMode)
+{
+	if (!_streamVAO)
+		return;
+
+	updateUniforms(shader);
+
+	shader->use();
+
+	glBindVertexArray(_streamVAO);
+	glPolygonMode(GL_FRONT_AND_BACK, polygonMode);
+	glDrawElements(_type, _streamCount, GL_UNSIGNED_INT, (GLvoid*)_streamIndices.offset());
+
+	//regions read by this draw are not written again until it finishes
+	_streamVertices.fence();
+	_streamIndices.fence();
+
+	//cleanup
+	glBindVertexArray(0);
+	glUseProgram(0);
+}
+
+void Mesh::computeInitialQuad(SimpleVertex& v)
+{
+	glm::vec3 e1;
+	glm::vec3 e2;
+	glm::vec3 normal;
+	glm::vec4 plane;
+	glm::mat4 quad(.0f);
+	AttributeQuadric attributeQuad;
+	for (const GLuint* it = _vertexFaces.begin(v._id); it != _vertexFaces.end(v._id); ++it)
+	{
+		const Face& f = _faces[*it];
+
+		//attributes of the vertex' corner in this face
+		if (!_wedges.empty())
+			for (size_t i = 0; i < 3; ++i)
+				if (f._vertices[i] == v._id)
+					attributeQuad.add(_wedges[f._wedges[i]]);
+
+		//e1 = _simpleVertices[findVertexPosition(f._vertices[1])]._position - _simpleVertices[findVertexPosition(f._vertices[0])]._position;
+		//e2 = _simpleVertices[findVertexPosition(f._vertices[2])]._position - _simpleVertices[findVertexPosition(f._vertices[0])]._position;
+		e1 = getVertex(f._vertices[1])._position - getVertex(f._vertices[0])._position;
+		e2 = getVertex(f._vertices[2])._position - getVertex(f._vertices[0])._position;
+		normal = glm::cross(e1, e2);
+
+		//unit normal, so the quadric error is a sum of squared distances
+		if (glm::length(normal) == .0f)
+			continue;
+		normal = glm::normalize(normal);
+
+		plane = { normal, -glm::dot(v._position, normal) };
+		quad += glm::outerProduct(plane, plane);
+	}
+
+	v._quad = quad;
+	v._attributeQuad = attributeQuad;
+
+	//if (!(v._id % 1000)
+	//{
+	//	std::cout << ">computing quadrics:	" << 100.f * v._id / _simpleVertices.size() << "%" << std::endl;
+	//}
+}
+
+void Mesh::computeConstraintQuads(const EdgeTable& edges, GLfloat weight)
+{
+	if (weight <= .0f)
+		return;
+
+	//vertex ID -> position in _simpleVertices
+	std::vector<GLuint> slot;
+	for (size_t i = 0; i < _simpleVertices.size(); ++i)
+	{
+		if (_simpleVertices[i]._id >= slot.size())
+			slot.resize(_simpleVertices[i]._id + 1);
+		slot[_simpleVertices[i]._id] = i;
+	}
+
+	//attribute vertex of a corner of face
+	auto wedge = [](const Face& f, GLuint v)
+	{
+		for (size_t k = 0; k < 3; ++k)
+			if (f._vertices[k] == v)
+				return f._wedges[k];
+		return f._wedges[0];
+	};
+
+	for (size_t e = 0; e < edges.size(); ++e)
+	{
+		GLuint count = edges._faceCounts[e];
+		const std::array<GLuint, 2>& edgeFaces = edges._faces[e];
+
+		//interior edge with continuous attributes on both sides
+		bool constrained = count != 2;
+		if (!constrained && !_wedges.empty())
+			for (GLuint v : { edges.first(e), edges.second(e) })
+				constrained = constrained || wedge(_faces[edgeFaces[0]], v) != wedge(_faces[edgeFaces[1]], v);
+		if (!constrained)
+			continue;
+
+		SimpleVertex& a = _simpleVertices[slot[edges.first(e)]];
+		SimpleVertex& b = _simpleVertices[slot[edges.second(e)]];
+
+		//plane containing the edge, perpendicular to every adjacent face (first two faces of non-manifold edges)
+		for (GLuint fId : edgeFaces)
+		{
+			if (fId == NO_FACE)
+				continue;
+
+			const Face& f = _faces[fId];
+			glm::vec3 p0 = _simpleVertices[slot[f._vertices[0]]]._position;
+			glm::vec3 faceNormal = glm::cross(_simpleVertices[slot[f._vertices[1]]]._position - p0, _simpleVertices[slot[f._vertices[2]]]._position - p0);
+			glm::vec3 normal = glm::cross(b._position - a._position, faceNormal);
+
+			if (glm::length(normal) == .0f)
+				continue;
+			normal = glm::normalize(normal);
+
+			glm::vec4 plane(normal, -glm::dot(a._position, normal));
+			glm::mat4 quad = weight * glm::outerProduct(plane, plane);
+			a._quad += quad;
+			b._quad += quad;
+		}
+	}
+}
+
+void Mesh::pushPair(const Pair& pair)
+{
+	_pairsQueue.push({ pair._cost, pair._cost, pair._vertices, { _stamps[pair._vertices[0]], _stamps[pair._vertices[1]] } });
+}
+
+void Mesh::computeInitialCost()
+{
+	//a single pass reads every vertex a few times, so pairs read the vertices in place (IDs are equal to positions here)
+	bool attributes = _attributeScale > .0f;
+	std::vector<PairEntry> entries(_pairs.size());
+	parallelFor(0, _pairs.size(), [&](size_t i)
+	{
+		const SimpleVertex& a = _simpleVertices[_pairs[i]._vertices[0]];
+		const SimpleVertex& b = _simpleVertices[_pairs[i]._vertices[1]];
+		GLfloat cost = edgeCost(a._position, b._position, a._quad, b._quad);
+		if (attributes)
+			cost += _attributeScale * (a._attributeQuad + b._attributeQuad).error();
+
+		//entries are heapified at once instead of pushed one by one
+		_pairs[i]._cost = cost;
+		entries[i] = { cost, cost, _pairs[i]._vertices, { _stamps[_pairs[i]._vertices[0]], _stamps[_pairs[i]._vertices[1]] } };
+	});
+	_pairsQueue = decltype(_pairsQueue)(std::greater<PairEntry>(), std::move(entries));
+}
+
+void Mesh::computeCost(GLuint vertexId)
+{
+	//pairs of vertex are the edges to its neighbors, costed in one batch
+	bool attributes = _attributeScale > .0f;
+	SimpleVertex& v = getVertex(vertexId);
+	_ring.clear();
+	_ring.push(v, attributes);
+	for (auto n : v._neighbors)
+		_ring.pushEdge(0, _ring.push(getVertex(n), attributes));
+	_ring.edgeCosts(_attributeScale, _costs);
+
+	for (size_t i = 0; i < _costs.size(); ++i)
+		pushPair(Pair(vertexId, _ring._ids[i + 1], _costs[i]));
+}
+
+//vertices and faces are always kept sorted by ID (new ones get the highest ID), so binary search is enough
+SimpleVertex& Mesh::getVertex(const GLuint id)
+{
+	return _simpleVertices[findVertexPosition(id)];
+}
+
+Face& Mesh::getFace(const GLuint id)
+{
+	return _faces[findFacePosition(id)];
+}
+
+GLuint Mesh::findVertexPosition(const GLuint id)
+{
+	return std::lower_bound(_simpleVertices.begin(), _simpleVertices.end(), id, [](const SimpleVertex& v, GLuint id) { return v._id < id; }) - _simpleVertices.begin();
+}
+GLuint Mesh::findFacePosition(const GLuint id)
+{
+	return std::lower_bound(_faces.begin(), _faces.end(), id, [](const Face& f, GLuint id) { return f._id < id; }) - _faces.begin();
+}
+GLuint Mesh::findPairPosition(const GLuint id)
+{
+	for (size_t i = 0; i < _pairs.size(); ++i)
+		if (_pairs[i]._id == id) return i;
+}
+
+bool Mesh::contains(GLuint faceId, GLuint vertexId)
+{
+	if
+	(
+		getFace(faceId)._vertices[0] == vertexId ||
+		getFace(faceId)._vertices[1] == vertexId ||
+		getFace(faceId)._vertices[2] == vertexId
+	) return true;
+	return false;
+}
+
+bool Mesh::isCollapseValid(GLuint newId, GLuint oldId)
+{
+	SimpleVertex& n = getVertex(newId);
+	SimpleVertex& o = getVertex(oldId);
+	glm::vec3 newPosition = (n._position + o._position) / 2.f;
+
+	//link condition: common neighbors of both vertices are exactly the opposite vertices of the edge's faces
+	size_t edgeFaces = 0;
+	for (auto f : n._faces)
+		if (contains(f, oldId))
+			++edgeFaces;
+
+	size_t common = 0;
+	auto i = n._neighbors.begin();
+	auto j = o._neighbors.begin();
+	while (i != n._neighbors.end() && j != o._neighbors.end())
+	{
+		if (*i < *j)
+			++i;
+		else if (*j < *i)
+			++j;
+		else
+		{
+			++common;
+			++i;
+			++j;
+		}
+	}
+	if (edgeFaces == 0 || edgeFaces > 2 || common != edgeFaces)
+		return false;
+
+	//the collapse would remove the last faces of the component
+	if (n._faces.size() + o._faces.size() <= 2 * edgeFaces)
+		return false;
+
+	//interior edge between two boundary vertices would pinch the surface
+	if (edgeFaces == 2 && n._neighbors.size() != n._faces.size() && o._neighbors.size() != o._faces.size())
+		return false;
+
+	//no face of the one-ring may fold over
+	for (SimpleVertex* v : { &n, &o })
+		for (auto fId : v->_faces)
+		{
+			const Face& f = getFace(fId);
+			if (contains(fId, newId) && contains(fId, oldId))
+				continue;
+
+			std::array<glm::vec3, 3> p;
+			for (size_t k = 0; k < 3; ++k)
+				p[k] = f._vertices[k] == v->_id ? v->_position : getVertex(f._vertices[k])._position;
+			glm::vec3 before = glm::cross(p[1] - p[0], p[2] - p[0]);
+
+			for (size_t k = 0; k < 3; ++k)
+				if (f._vertices[k] == v->_id)
+					p[k] = newPosition;
+			glm::vec3 after = glm::cross(p[1] - p[0], p[2] - p[0]);
+
+			if (glm::dot(before, after) <= COLLAPSE_FLIP_LIMIT * glm::length(before) * glm::length(after))
+				return false;
+		}
+
+	return true;
+}
+
+void Mesh::collapse(GLuint newId, GLuint oldId)
+{
+	_scratch.reset();
+
+	glm::vec3 newPosition = (getVertex(newId)._position + getVertex(oldId)._position) / 2.f;
+	glm::mat4 newQuad = getVertex(newId)._quad + getVertex(oldId)._quad;
+	AttributeQuadric newAttributeQuad = getVertex(newId)._attributeQuad + getVertex(oldId)._attributeQuad;
+
+	SmallSet<GLuint, 8> newNeighbors;
+	for (auto& n : getVertex(newId)._neighbors)
+		newNeighbors.insert(n);
+	for (auto& n : getVertex(oldId)._neighbors)
+		newNeighbors.insert(n);
+
+	newNeighbors.erase(oldId);
+	newNeighbors.erase(newId);
+
+	getVertex(newId)._position = newPosition;
+	getVertex(newId)._neighbors = std::move(newNeighbors);
+	getVertex(newId)._quad = newQuad;
+	getVertex(newId)._attributeQuad = newAttributeQuad;
+	getVertex(newId)._size = std::min(getVertex(newId)._size, getVertex(oldId)._size);
+
+	//	update neighbors
+	for (auto& n : getVertex(newId)._neighbors)
+	{
+		getVertex(n)._neighbors.erase(oldId);
+		getVertex(n)._neighbors.insert(newId);
+	}
+
+	//update faces
+	//	select faces to be removed
+	ArenaVector<GLuint> faces(_scratch);
+	for (auto& f : getVertex(newId)._faces)
+		if (contains(f, oldId))
+			faces.push_back(f);
+
+	//	merge attribute vertices before corners of oldId are renamed
+	if (!_wedges.empty())
+		collapseWedges(newId, oldId, faces);
+
+	//	insert v2's faces ids to v1
+	for (auto& f : getVertex(oldId)._faces)
+		getVertex(newId)._faces.insert(f);
+
+	//remove ereased faces from new vertex
+	for (auto f : faces)
+		getVertex(newId)._faces.erase(f);
+
+	//	remove oldId from all faces
+	for (auto& f : getVertex(newId)._faces)
+		for (size_t i = 0; i < 3; ++i)
+			if (getFace(f)._vertices[i] == oldId)
+				getFace(f)._vertices[i] = newId;
+
+	//remove deleted faces ids from all neighbors
+	for (auto& n : getVertex(newId)._neighbors)
+		for (auto f : faces)
+			getVertex(n)._faces.erase(f);
+
+	for (auto f : faces)
+		_faces.erase(_faces.begin() + findFacePosition(f));
+
+	//	delete vertex
+	_simpleVertices.erase(_simpleVertices.begin() + findVertexPosition(oldId));
+}
+
+void Mesh::collapseWedges(GLuint newId, GLuint oldId, const ArenaVector<GLuint>& removedFaces)
+{
+	//old wedge -> new wedge, taken from corners of removed faces
+	ArenaVector<std::pair<GLuint, GLuint>> merged(_scratch);
+	for (auto fId : removedFaces)
+	{
+		Face& f = getFace(fId);
+		GLuint newWedge = 0, oldWedge = 0;
+		for (size_t i = 0; i < 3; ++i)
+		{
+			if (f._vertices[i] == newId)
+				newWedge = f._wedges[i];
+			else if (f._vertices[i] == oldId)
+				oldWedge = f._wedges[i];
+		}
+
+		bool known = newWedge == oldWedge;
+		for (auto& m : merged)
+			known = known || m.first == oldWedge;
+		if (known)
+			continue;
+		merged.push_back({ oldWedge, newWedge });
+
+		//the new vertex lies in the middle of the edge, so are its attributes
+		Vertex& n = _wedges[newWedge];
+		const Vertex& o = _wedges[oldWedge];
+		n._color = (n._color + o._color) / 2.f;
+		n._texcoord = (n._texcoord + o._texcoord) / 2.f;
+		n._normal = n._normal + o._normal;
+		if (glm::length(n._normal) > .0f)
+			n._normal = glm::normalize(n._normal);
+	}
+
+	//rename wedges in remaining faces of old vertex
+	for (auto fId : getVertex(oldId)._faces)
+	{
+		Face& f = getFace(fId);
+		for (size_t i = 0; i < 3; ++i)
+			if (f._vertices[i] == oldId)
+				for (auto& m : merged)
+					if (f._wedges[i] == m.first)
+					{
+						f._wedges[i] = m.second;
+						break;
+					}
+	}
+}
+
+void Mesh::buildAttributeBuffers()
+{
+	_vertices.clear();
+	_indices.clear();
+	if (_wedges.empty())
+		return;
+
+	//every used wedge becomes one output vertex at the position of its simple vertex
+	std::vector<GLuint> remap(_wedges.size(), std::numeric_limits<GLuint>::max());
+	for (auto& f : _faces)
+		for (size_t i = 0; i < 3; ++i)
+		{
+			GLuint w = f._wedges[i];
+			if (remap[w] == std::numeric_limits<GLuint>::max())
+			{
+				remap[w] = _vertices.size();
+				_vertices.push_back(_wedges[w]);
+				_vertices.back()._position = getVertex(f._vertices[i])._position;
+			}
+			_indices.push_back(remap[w]);
+		}
+}
+
+void Mesh::simplifyMesh(const SimplifyTarget& target)
+{
+	const size_t inputVertices = _simpleVertices.size();
+
+	//attribute error is measured relative to 1% of the bounding box diagonal
+	_attributeScale = .0f;
+	if (!_wedges.empty() && target._attributeWeight > .0f)
+	{
+		glm::vec3 minPosition(FLT_MAX);
+		glm::vec3 maxPosition(-FLT_MAX);
+		for (auto& v : _simpleVertices)
+		{
+			minPosition = glm::min(minPosition, v._position);
+			maxPosition = glm::max(maxPosition, v._position);
+		}
+		GLfloat unit = .01f * glm::length(maxPosition - minPosition);
+		_attributeScale = target._attributeWeight * unit * unit;
+	}
+
+	//select all valid pairs
+	//	set neighbors and faces of all vertices, find unique edges with their faces
+	buildAdjacency();
+	EdgeTable edges;
+	edges.build(_faces);
+
+	//compute the Q matrices for all vertices (every vertex reads the faces around it and writes only its own quadric)
+	parallelFor(0, _simpleVertices.size(), [&](size_t i) { computeInitialQuad(_simpleVertices[i]); });
+	computeConstraintQuads(edges, target._boundaryWeight);
+
+	//the rings are the only incidence kept while collapsing
+	_vertexFaces = Adjacency();
+
+	//	update pairs: unique edges of faces
+	_pairs.resize(edges.size());
+	parallelFor(0, edges.size(), [&](size_t i)
+	{
+		_pairs[i] = Pair(edges.first(i), edges.second(i));
+		_pairs[i]._id = i;
+	});
+
+	//every vertex starts with stamp 0
+	GLuint maxId = 0;
+	for (auto& v : _simpleVertices)
+		maxId = std::max(maxId, v._id);
+	_stamps.assign(maxId + 1, 0);
+
+	//compute the optimal contraction target for each valid pair; the error of this target vertex becomes the cost of contracting that pair
+	computeInitialCost();
+
+	_simplifyError = .0f;
+	size_t collapses = 0;
+	while (!_pairsQueue.empty())
+	{
+		//take the pair with the lowest cost, skip stale entries
+		PairEntry top = _pairsQueue.top();
+		if (!isValid(top))
+		{
+			_pairsQueue.pop();
+			continue;
+		}
+
+		//stopping criteria are checked against the top of the queue
+		if (target.reached(_simpleVertices.size(), inputVertices, _faces.size(), top._cost))
+			break;
+		_pairsQueue.pop();
+
+		//iteratively remove the pair (v1, v2) of lest cost, contract this pair, and update the costs of all valid pairs involving v
+		GLuint newId = top._vertices[0];
+		GLuint oldId = top._vertices[1];
+
+		//folding or non-manifold collapse, try again later with a penalty
+		if (!isCollapseValid(newId, oldId))
+		{
+			if (++top._rejections <= COLLAPSE_MAX_REJECTIONS)
+			{
+				top._priority = top._priority * COLLAPSE_PENALTY + FLT_MIN;
+				_pairsQueue.push(top);
+			}
+			continue;
+		}
+
+		collapse(newId, oldId);
+		_simplifyError = std::max(_simplifyError, top._cost);
+
+		//invalidate queue entries of both vertices
+		++_stamps[newId];
+		++_stamps[oldId];
+
+		//compute the optimal contraction target for each valid pair; the error of this target vertex becomes the cost of contracting that pair
+		computeCost(newId);
+
+		if (++collapses % PREVIEW_COLLAPSES == 0)
+			preview();
+	}
+
+	//the queue and stamps track live edges during the loop, pairs are rebuilt once for the wireframe and remeshing
+	buildPairs();
+}
+void Mesh::buildAdjacency()
+{
+	Adjacency neighbors;
+	_vertexFaces.buildFaces(_simpleVertices.size(), _faces);
+	neighbors.buildNeighbors(_simpleVertices.size(), _faces);
+
+	//mutable rings start as copies of the static adjacency
+	parallelFor(0, _simpleVertices.size(), [&](size_t i)
+	{
+		SimpleVertex& v = _simpleVertices[i];
+		v._neighbors.clear();
+		v._faces.clear();
+		for (const GLuint* it = neighbors.begin(v._id); it != neighbors.end(v._id); ++it)
+			v._neighbors.insert(*it);
+		for (const GLuint* it = _vertexFaces.begin(v._id); it != _vertexFaces.end(v._id); ++it)
+			v._faces.insert(_faces[*it]._id);
+	});
+}
+
+void Mesh::buildTopology()
+{
+	buildAdjacency();
+	_vertexFaces = Adjacency();
+	buildPairs();
+}
+
+/**
+ * finds the minimum of a quadric
+ * @param quad quadric matrix
+ * @param position output position
+ * @return false if the quadric is (nearly) singular
+ */
+static bool quadricMinimum(const glm::mat4& quad, glm::vec3& position)
+{
+	glm::dmat3 A(quad);
+	glm::dvec3 b(quad[3]);
+
+	GLdouble scale = std::max(std::max(A[0][0], A[1][1]), A[2][2]);
+	GLdouble det = glm::determinant(A);
+	if (scale <= 0.0 || std::abs(det) < 1e-6 * scale * scale * scale)
+		return false;
+
+	position = glm::vec3(-(glm::inverse(A) * b));
+	return true;
+}
+
+/**
+ * returns key of the grid cell containing the point
+ * @param position point
+ * @param origin minimal corner of the grid
+ * @param cellSize edge length of the cell
+ * @param resolution cells along each axis
+ * @return cell key
+ */
+static uint64_t cellKey(const glm::vec3& position, const glm::vec3& origin, GLfloat cellSize, uint64_t resolution)
+{
+	glm::vec3 c = (position - origin) / cellSize;
+	uint64_t x = std::min(resolution - 1, static_cast<uint64_t>(std::max(c.x, .0f)));
+	uint64_t y = std::min(resolution - 1, static_cast<uint64_t>(std::max(c.y, .0f)));
+	uint64_t z = std::min(resolution - 1, static_cast<uint64_t>(std::max(c.z, .0f)));
+	return x + resolution * (y + resolution * z);
+}
+
+void Mesh::clusterMesh(const SimplifyTarget& target)
+{
+	const size_t n = _simpleVertices.size();
+	if (n == 0)
+		return;
+
+	//bounding box
+	glm::vec3 minPosition(FLT_MAX);
+	glm::vec3 maxPosition(-FLT_MAX);
+	for (auto& v : _simpleVertices)
+	{
+		minPosition = glm::min(minPosition, v._position);
+		maxPosition = glm::max(maxPosition, v._position);
+	}
+	glm::vec3 size = maxPosition - minPosition;
+	GLfloat extent = std::max(std::max(size.x, size.y), std::max(size.z, 1e-6f));
+
+	//grid resolution
+	uint64_t resolution = target._gridResolution;
+	if (resolution == 0)
+	{
+		size_t targetVertices = target.targetVertices(n);
+		if (targetVertices > 0)
+		{
+			//occupied cells grow with the square of the resolution on a surface, two trial grids are enough
+			resolution = 64;
+			std::vector<uint64_t> keys(n);
+			for (int trial = 0; trial < 2; ++trial)
+			{
+				GLfloat trialSize = extent / resolution;
+				parallelFor(0, n, [&](size_t i) { keys[i] = cellKey(_simpleVertices[i]._position, minPosition, trialSize, resolution); });
+				std::sort(keys.begin(), keys.end());
+				size_t occupied = std::unique(keys.begin(), keys.end()) - keys.begin();
+
+				resolution = std::max<uint64_t>(1, static_cast<uint64_t>(resolution * std::sqrt(static_cast<GLdouble>(targetVertices) / occupied)));
+			}
+		}
+		else if (target._maxError > .0f)
+			//half of the cell diagonal equals the tolerated distance
+			resolution = static_cast<uint64_t>(std::ceil(extent * std::sqrt(3.f) / (2.f * std::sqrt(target._maxError))));
+		else
+			resolution = 1;
+	}
+	resolution = std::max<uint64_t>(1, std::min<uint64_t>(resolution, 1 << 20));
+	GLfloat cellSize = extent / resolution;
+
+	//vertex -> cell key
+	std::vector<GLuint> slot;
+	for (size_t i = 0; i < n; ++i)
+	{
+		if (_simpleVertices[i]._id >= slot.size())
+			slot.resize(_simpleVertices[i]._id + 1);
+		slot[_simpleVertices[i]._id] = i;
+	}
+
+	std::vector<uint64_t> keys(n);
+	parallelFor(0, n, [&](size_t i) { keys[i] = cellKey(_simpleVertices[i]._position, minPosition, cellSize, resolution); });
+
+	//occupied cells become clusters
+	std::vector<uint64_t> cells(keys);
+	std::sort(cells.begin(), cells.end());
+	cells.erase(std::unique(cells.begin(), cells.end()), cells.end());
+
+	std::vector<GLuint> cluster(n);
+	parallelFor(0, n, [&](size_t i) { cluster[i] = std::lower_bound(cells.begin(), cells.end(), keys[i]) - cells.begin(); });
+
+	//area weighted face quadrics
+	const size_t faceCount = _faces.size();
+	std::vector<glm::mat4> faceQuads(faceCount);
+	parallelFor(0, faceCount, [&](size_t i)
+	{
+		const Face& f = _faces[i];
+		glm::vec3 p0 = _simpleVertices[slot[f._vertices[0]]]._position;
+		glm::vec3 normal = glm::cross(_simpleVertices[slot[f._vertices[1]]]._position - p0, _simpleVertices[slot[f._vertices[2]]]._position - p0);
+		GLfloat length = glm::length(normal);
+
+		if (length == .0f)
+			faceQuads[i] = glm::mat4(.0f);
+		else
+		{
+			normal /= length;
+			glm::vec4 plane(normal, -glm::dot(p0, normal));
+			faceQuads[i] = (length / 2.f) * glm::outerProduct(plane, plane);
+		}
+	});
+
+	//group face corners and vertices by cluster (counting sort); a face is listed once per cluster it touches, so its quadric is not added twice
+	auto firstCorner = [&](const Face& f, size_t k)
+	{
+		for (size_t j = 0; j < k; ++j)
+			if (cluster[slot[f._vertices[j]]] == cluster[slot[f._vertices[k]]])
+				return false;
+		return true;
+	};
+	const size_t clusterCount = cells.size();
+	std::vector<GLuint> cornerOffsets(clusterCount + 1, 0);
+	std::vector<GLuint> vertexOffsets(clusterCount + 1, 0);
+	for (auto& f : _faces)
+		for (size_t k = 0; k < 3; ++k)
+			if (firstCorner(f, k))
+				++cornerOffsets[cluster[slot[f._vertices[k]]] + 1];
+	for (size_t i = 0; i < n; ++i)
+		++vertexOffsets[cluster[i] + 1];
+	for (size_t c = 0; c < clusterCount; ++c)
+	{
+		cornerOffsets[c + 1] += cornerOffsets[c];
+		vertexOffsets[c + 1] += vertexOffsets[c];
+	}
+
+	std::vector<GLuint> corners(cornerOffsets[clusterCount]);
+	std::vector<GLuint> members(n);
+	{
+		std::vector<GLuint> cornerFill(cornerOffsets.begin(), cornerOffsets.end() - 1);
+		std::vector<GLuint> vertexFill(vertexOffsets.begin(), vertexOffsets.end() - 1);
+		for (size_t i = 0; i < faceCount; ++i)
+			for (size_t k = 0; k < 3; ++k)
+				if (firstCorner(_faces[i], k))
+					corners[cornerFill[cluster[slot[_faces[i]._vertices[k]]]]++] = i;
+		for (size_t i = 0; i < n; ++i)
+			members[vertexFill[cluster[i]]++] = i;
+	}
+
+	//cluster representatives
+	std::vector<SimpleVertex> clusters(clusterCount);
+	parallelFor(0, clusterCount, [&](size_t c)
+	{
+		glm::mat4 quad(.0f);
+		for (GLuint i = cornerOffsets[c]; i < cornerOffsets[c + 1]; ++i)
+			quad += faceQuads[corners[i]];
+
+		glm::vec3 mean(.0f);
+		for (GLuint i = vertexOffsets[c]; i < vertexOffsets[c + 1]; ++i)
+			mean += _simpleVertices[members[i]]._position;
+		mean /= static_cast<GLfloat>(vertexOffsets[c + 1] - vertexOffsets[c]);
+
+		//the quadric minimum is used only if it stays close to the cell
+		glm::vec3 position;
+		if (!quadricMinimum(quad, position) || glm::length(position - mean) > cellSize)
+			position = mean;
+
+		clusters[c]._id = c;
+		clusters[c]._position = position;
+		clusters[c]._quad = quad;
+	});
+
+	//squared displacement of the farthest vertex is the error of clustering
+	std::vector<GLfloat> errors(parallelThreads(n), .0f);
+	parallelChunks(0, n, [&](size_t chunkBegin, size_t chunkEnd, size_t thread)
+	{
+		for (size_t i = chunkBegin; i < chunkEnd; ++i)
+		{
+			glm::vec3 d = _simpleVertices[i]._position - clusters[cluster[i]]._position;
+			errors[thread] = std::max(errors[thread], glm::dot(d, d));
+		}
+	});
+	_simplifyError = *std::max_element(errors.begin(), errors.end());
+
+	//faces with three different clusters survive, duplicates are removed
+	std::vector<std::array<GLuint, 3>> triangles(faceCount);
+	parallelFor(0, faceCount, [&](size_t i)
+	{
+		for (size_t j = 0; j < 3; ++j)
+			triangles[i][j] = cluster[slot[_faces[i]._vertices[j]]];
+		std::sort(triangles[i].begin(), triangles[i].end());
+	});
+	triangles.erase(std::remove_if(triangles.begin(), triangles.end(), [](const std::array<GLuint, 3>& t)
+	{
+		return t[0] == t[1] || t[1] == t[2];
+	}), triangles.end());
+	std::sort(triangles.begin(), triangles.end());
+	triangles.erase(std::unique(triangles.begin(), triangles.end()), triangles.end());
+
+	//one averaged wedge per cluster
+	if (!_wedges.empty())
+	{
+		std::vector<Vertex> wedges(clusterCount, Vertex());
+		std::vector<GLfloat> weights(clusterCount, .0f);
+		for (auto& f : _faces)
+			for (size_t i = 0; i < 3; ++i)
+			{
+				GLuint c = cluster[slot[f._vertices[i]]];
+				wedges[c]._color += _wedges[f._wedges[i]]._color;
+				wedges[c]._texcoord += _wedges[f._wedges[i]]._texcoord;
+				wedges[c]._normal += _wedges[f._wedges[i]]._normal;
+				weights[c] += 1.f;
+			}
+		for (size_t c = 0; c < clusterCount; ++c)
+			if (weights[c] > .0f)
+			{
+				wedges[c]._color /= weights[c];
+				wedges[c]._texcoord /= weights[c];
+				if (glm::length(wedges[c]._normal) > .0f)
+					wedges[c]._normal = glm::normalize(wedges[c]._normal);
+			}
+		_wedges.swap(wedges);
+	}
+
+	//output in the same structures as QEM
+	_simpleVertices.swap(clusters);
+	_faces.clear();
+	_faces.reserve(triangles.size());
+	for (size_t i = 0; i < triangles.size(); ++i)
+		_faces.push_back(Face(i, triangles[i], triangles[i]));
+
+	buildTopology();
+}
+
+/*
+std::array<std::array<GLdouble, 3>, 3> transpose(std::array<std::array<GLdouble, 3>, 3> matrix)
+{
+	return
+	{{
+		{matrix[0][0], matrix[1][0], matrix[2][0]},
+		{matrix[0][1], matrix[1][1], matrix[2][1]},
+		{matrix[0][2], matrix[1][2], matrix[2][2]}
+	}};
+}
+
+GLdouble det(GLdouble a, GLdouble b, GLdouble c, GLdouble d)
+{
+	return a * d - b * c;
+}
+
+std::array<std::array<GLdouble, 3>, 3> inverse(std::array<std::array<GLdouble, 3>, 3> matrix)
+{
+	GLdouble det0 = matrix[0][0] * det(matrix[1][1], matrix[1][2], matrix[2][1], matrix[2][2]) - matrix[0][1] * det(matrix[1][0], matrix[1][2], matrix[2][0], matrix[2][2]) + matrix[0][2] * det(matrix[1][0], matrix[1][1], matrix[2][0], matrix[2][1]);
+	matrix = transpose(matrix);
+
+	return
+	{{
+		{
+			det(matrix[1][1], matrix[1][2], matrix[2][1], matrix[2][2]) / det0,
+			-det(matrix[1][0], matrix[1][2], matrix[2][0], matrix[2][2]) / det0,
+			det(matrix[1][0], matrix[1][1], matrix[2][0], matrix[2][1]) / det0
+		},
+		{
+			-det(matrix[0][1], matrix[0][2], matrix[2][1], matrix[2][2]) / det0,
+			det(matrix[0][0], matrix[0][2], matrix[2][0], matrix[2][2]) / det0,
+			-det(matrix[0][0], matrix[0][1], matrix[2][0], matrix[2][1]) / det0
+		},
+		{
+			det(matrix[0][1], matrix[0][2], matrix[1][1], matrix[1][2]) / det0,
+			-det(matrix[0][0], matrix[0][2], matrix[1][0], matrix[1][2]) / det0,
+			det(matrix[0][0], matrix[0][1], matrix[1][0], matrix[1][1]) / det0
+		}
+	}};
+}
+
+std::array<std::array<GLdouble, 3>, 3> sum(std::array<std::array<GLdouble, 3>, 3> matrix1, std::array<std::array<GLdouble, 3>, 3> matrix2)
+{
+	std::array<std::array<GLdouble, 3>, 3> result;
+
+	for (int i = 0; i < 3; ++i)
+		for (int j = 0; j < 3; ++j)
+			result[i][j] = matrix1[i][j] + matrix2[i][j];
+
+	return result;
+}
+
+std::array<std::array<GLdouble, 3>, 3> multiply(std::array<std::array<GLdouble, 3>, 3> matrix1, std::array<std::array<GLdouble, 3>, 3> matrix2)
+{
+	std::array<std::array<GLdouble, 3>, 3> result;
+
+	for (int i = 0; i < 3; ++i)
+		for (int j = 0; j < 3; ++j)
+		{
+			result[i][j] = 0;
+			for (int k = 0; k < 3; ++k)
+				result[i][j] += matrix1[i][k] * matrix2[k][j];
+		}
+
+	return result;
+}
+
+std::array<std::array<GLdouble, 3>, 3> divide(std::array<std::array<GLdouble, 3>, 3> matrix, GLdouble scalar)
+{
+	for (int i = 0; i < 3; ++i)
+		for (int j = 0; j < 3; ++j)
+			matrix[i][j] /= scalar;
+	return matrix;
+}
+
+std::array<std::array<GLdouble, 3>, 3> pseudoInverse(std::array<std::array<GLdouble, 3>, 3> matrix)
+{
+	return multiply(inverse(multiply(transpose(matrix), matrix)), transpose(matrix));
+}
+
+std::array<std::array<GLdouble, 3>, 3> findTransformationMatrix(std::array<std::array<GLdouble, 3>, 3> triangle, std::array<std::array<GLdouble, 3>, 3> invUnit)
+{
+	return multiply(triangle, invUnit);
+}
+
+std::array<std::array<GLdouble, 3>, 3> getRotationMatrix(std::array<std::array<GLdouble, 3>, 3> matrix)
+{
+	Eigen::Matrix<double, 3, 3> T
+	{
+		{matrix[0][0], matrix[0][1], matrix[0][2]},
+		{matrix[1][0], matrix[1][1], matrix[1][2]},
+		{matrix[2][0], matrix[2][1], matrix[2][2]}
+	};
+
+	Eigen::BDCSVD<Eigen::Matrix<double, 3, 3>> svd(T, Eigen::ComputeFullU | Eigen::ComputeFullV);
+
+	auto U = svd.matrixU();
+	auto V = svd.matrixV();
+
+	auto R = U * (V.transpose());
+
+	for (int i = 0; i < 3; ++i)
+		for (int j = 0; j < 3; ++j)
+			matrix[i][j] = R(i, j);
+
+	return matrix;
+}
+
+GLdouble area(std::array<std::array<GLdouble, 3>, 3> triangle)
+{
+	GLdouble a, b, c;
+	a = sqrt(pow(triangle[0][1] - triangle[0][0], 2.0) + pow(triangle[1][1] - triangle[1][0], 2.0) + pow(triangle[2][1] - triangle[2][0], 2.0));
+	b = sqrt(pow(triangle[0][2] - triangle[0][0], 2.0) + pow(triangle[1][2] - triangle[1][0], 2.0) + pow(triangle[2][2] - triangle[2][0], 2.0));
+	c = sqrt(pow(triangle[0][2] - triangle[0][1], 2.0) + pow(triangle[1][2] - triangle[1][1], 2.0) + pow(triangle[2][2] - triangle[2][1], 2.0));
+
+	GLdouble s = (a + b + c) / 2.0;
+	return sqrt(s * (s - a) * (s - b) * (s - c));
+}
+
+GLdouble calculateScale(std::array<std::array<GLdouble, 3>, 3> triangle)
+{
+	GLdouble unitArea = sqrt(3.0) / 4.0;
+
+	return sqrt(area(triangle) / unitArea);
+}
+
+void Mesh::aeap()
+{
+	std::array<std::array<GLdouble, 3>, 3> unit = { {{-0.5 + 1.0, 0.0 + 1.0, 0.0 + 1.0}, {0.5 + 1.0, 0.0 + 1.0, 0.0 + 1.0}, {0.0 + 1.0, 0.0 + 1.0, sqrt(3.0) / 2.0 + 1.0}} };
+	std::array<std::array<GLdouble, 3>, 3> invUnit = pseudoInverse(unit);
+
+	std::array<std::array<GLdouble, 3>, 3> equilateral;
+	std::vector<std::array<std::array<GLdouble, 3>, 3>> newTriangles;
+
+	std::array<std::array<GLdouble, 3>, 3> triangle;
+	std::array<std::array<GLdouble, 3>, 3> R;
+	std::vector<std::array<std::array<GLdouble, 3>, 3>> L;
+
+	GLdouble s;
+
+	//local step
+	for (auto& f : _faces)
+	{
+		triangle = 
+		{ {
+		{getVertex(f._vertices[0])._position.x, getVertex(f._vertices[1])._position.x, getVertex(f._vertices[2])._position.x},
+		{getVertex(f._vertices[0])._position.y, getVertex(f._vertices[1])._position.y, getVertex(f._vertices[2])._position.y},
+		{getVertex(f._vertices[0])._position.z, getVertex(f._vertices[1])._position.z, getVertex(f._vertices[2])._position.z}
+		} };
+
+		R = getRotationMatrix(findTransformationMatrix(triangle, invUnit));
+		s = calculateScale(triangle);
+		for (int i = 0; i < 3; ++i)
+			for (int j = 0; j < 3; ++j)
+				R[i][j] *= s;
+		equilateral = multiply(R, unit);
+		L.push_back(multiply(equilateral, pseudoInverse(triangle)));
+	}
+
+	//global step
+	int i = 0;
+	for (auto& f : _faces)
+	{
+		triangle =
+		{ {
+		{getVertex(f._vertices[0])._position.x, getVertex(f._vertices[1])._position.x, getVertex(f._vertices[2])._position.x},
+		{getVertex(f._vertices[0])._position.y, getVertex(f._vertices[1])._position.y, getVertex(f._vertices[2])._position.y},
+		{getVertex(f._vertices[0])._position.z, getVertex(f._vertices[1])._position.z, getVertex(f._vertices[2])._position.z}
+		} };
+
+		newTriangles.push_back(multiply((divide(sum(L[i], transpose(L[i])), area(triangle) / 2.0)), pseudoInverse(multiply(transpose(triangle), transpose(pseudoInverse(triangle))))));
+		++i;
+	}
+
+
+	i = 0;
+	for (auto& f : _faces)
+	{
+		getVertex(f._vertices[0])._position.x = newTriangles[i][0][0];
+		getVertex(f._vertices[0])._position.y = newTriangles[i][0][1];
+		getVertex(f._vertices[0])._position.z = newTriangles[i][0][2];
+
+		getVertex(f._vertices[1])._position.x = newTriangles[i][1][0];
+		getVertex(f._vertices[1])._position.y = newTriangles[i][1][1];
+		getVertex(f._vertices[1])._position.z = newTriangles[i][1][2];
+
+		getVertex(f._vertices[2])._position.x = newTriangles[i][2][0];
+		getVertex(f._vertices[2])._position.y = newTriangles[i][2][1];
+		getVertex(f._vertices[2])._position.z = newTriangles[i][2][2];
+		++i;
+	}
+
+}
+*/
+
+GLdouble calculateLength(GLdouble x, GLdouble y, GLdouble z)
+{
+	return sqrt(pow(x, 2.0) + pow(y, 2.0) + pow(z, 2.0));
+}
+
+void Mesh::split(size_t position)
+{
+	_scratch.reset();
+
+	//vertices are used by ID, adding the new vertex would invalidate references (and copies would not be updated)
+	const GLuint e1 = _pairs[position]._vertices[0];
+	const GLuint e2 = _pairs[position]._vertices[1];
+
+	//get faces
+	ArenaVector<GLuint> faces(_scratch);
+	for (auto& f : getVertex(e1)._faces)
+	{
+		if (contains(f, e2))
+			faces.push_back(f);
+	}
+	//std::cout << faces.size() << "\t";
+
+	//other vertices
+	ArenaVector<GLuint> v(_scratch);
+	for (int i = 0; i < faces.size(); ++i)
+		for (int j = 0; j < 3; ++j)
+			if (getFace(faces[i])._vertices[j] != e1 && getFace(faces[i])._vertices[j] != e2)
+				v.push_back(getFace(faces[i])._vertices[j]);
+
+	//std::cout << v.size() << "\t";
+
+	if (v.size() == faces.size() && v.size() == 2)
+	{
+		//add new vertex
+		glm::vec3 newPosition = (getVertex(e1)._position + getVertex(e2)._position) / 2.f;
+		GLuint newId = _simpleVertices[_simpleVertices.size() - 1]._id + 1;
+
+		_simpleVertices.push_back(SimpleVertex(newId, newPosition));
+		_simpleVertices.back()._size = .5f * (getVertex(e1)._size + getVertex(e2)._size);
+
+		//remove old faces from e2
+		for (auto f : faces)
+			getVertex(e2)._faces.erase(f);
+
+		//change starting faces' vertrices
+		for (int i = 0; i < faces.size(); ++i)
+		{
+			getFace(faces[i])._vertices[0] = e1;
+			getFace(faces[i])._vertices[1] = v[i];
+			getFace(faces[i])._vertices[2] = newId;
+			getFace(faces[i]).sortVertices();
+		}
+
+		//add neighbors to new Vertex
+		getVertex(newId)._neighbors.insert(e1);
+		getVertex(newId)._neighbors.insert(e2);
+		for (auto v_ : v)
+			getVertex(newId)._neighbors.insert(v_);
+
+		//remove neighbors from pair
+		getVertex(e1)._neighbors.erase(e2);
+		getVertex(e2)._neighbors.erase(e1);
+
+		//add new vertex to other vertices' neighbors
+		getVertex(e1)._neighbors.insert(newId);
+		getVertex(e2)._neighbors.insert(newId);
+		for (auto v_ : v)
+			getVertex(v_)._neighbors.insert(newId);
+
+		GLuint newFaceId;
+		//add faces and add them to vertices
+		for (auto v_ : v)
+		{
+			newFaceId = _faces[_faces.size() - 1]._id + 1;
+			_faces.push_back(Face(newFaceId, { {e2, v_, newId} }));
+
+			getVertex(e2)._faces.insert(newFaceId);
+			getVertex(v_)._faces.insert(newFaceId);
+			getVertex(newId)._faces.insert(newFaceId);
+		}
+		for (auto f : faces)
+			getVertex(newId)._faces.insert(f);
+
+		//update pairs
+		//	add new pairs
+		for (auto v_ : v)
+		{
+			_pairs.push_back(Pair(newId, v_));
+			_pairs[_pairs.size() - 1]._id = _pairs[_pairs.size() - 2]._id + 1;
+		}
+		_pairs.push_back(Pair(newId, e2));
+		_pairs[_pairs.size() - 1]._id = _pairs[_pairs.size() - 2]._id + 1;
+		//	change the starging pair
+		_pairs[position].set(e1, newId);
+	}
+	else
+		_pairs.erase(_pairs.begin() + position);
+}
+
+bool Mesh::flip(GLuint e1, GLuint e2)
+{
+	_scratch.reset();
+
+	//get faces
+	ArenaVector<GLuint> faces(_scratch);
+	for (auto& f : getVertex(e1)._faces)
+	{
+		if (contains(f, e2))
+			faces.push_back(f);
+	}
+	if (faces.size() != 2)
+		return false;
+
+	//other vertices (v[i] lies in faces[i])
+	ArenaVector<GLuint> v(_scratch);
+	for (int i = 0; i < faces.size(); ++i)
+		for (int j = 0; j < 3; ++j)
+			if (getFace(faces[i])._vertices[j] != e1 && getFace(faces[i])._vertices[j] != e2)
+				v.push_back(getFace(faces[i])._vertices[j]);
+	if (v.size() != 2 || v[0] == v[1] || getVertex(v[0])._neighbors.count(v[1]))
+		return false;
+
+	//valence deviation, regular valence is 6 inside and 4 on the boundary
+	auto deviation = [this](GLuint id, int change)
+	{
+		const SimpleVertex& vertex = getVertex(id);
+		int target = vertex._neighbors.size() == vertex._faces.size() ? 6 : 4;
+		return std::abs(static_cast<int>(vertex._neighbors.size()) + change - target);
+	};
+	if (getVertex(e1)._neighbors.size() <= 3 || getVertex(e2)._neighbors.size() <= 3)
+		return false;
+	int deviation1 = deviation(e1, 0) + deviation(e2, 0) + deviation(v[0], 0) + deviation(v[1], 0);
+	int deviation2 = deviation(e1, -1) + deviation(e2, -1) + deviation(v[0], 1) + deviation(v[1], 1);
+	if (deviation2 >= deviation1)
+		return false;
+
+	//faces are not wound, so the quad is oriented by (e1, e2, v0); both new faces have to face the same side as the old ones
+	glm::vec3 p1 = getVertex(e1)._position;
+	glm::vec3 p2 = getVertex(e2)._position;
+	glm::vec3 q0 = getVertex(v[0])._position;
+	glm::vec3 q1 = getVertex(v[1])._position;
+	glm::vec3 normal = glm::cross(p2 - p1, q0 - p1) + glm::cross(p1 - p2, q1 - p2);
+	if (glm::dot(glm::cross(p1 - q0, q1 - q0), normal) <= .0f || glm::dot(glm::cross(p2 - q1, q0 - q1), normal) <= .0f)
+		return false;
+
+	//remove faces from vertices
+	getVertex(e1)._faces.erase(faces[1]);
+	getVertex(e2)._faces.erase(faces[0]);
+
+	//update neighbors
+	getVertex(v[0])._neighbors.insert(v[1]);
+	getVertex(v[1])._neighbors.insert(v[0]);
+	getVertex(e1)._neighbors.erase(e2);
+	getVertex(e2)._neighbors.erase(e1);
+
+	//update faces and add them to vertices
+	getFace(faces[0])._vertices[0] = v[0];
+	getFace(faces[0])._vertices[1] = v[1];
+	getFace(faces[0])._vertices[2] = e1;
+	getVertex(v[1])._faces.insert(faces[0]);
+	getFace(faces[0]).sortVertices();
+
+	getFace(faces[1])._vertices[0] = v[0];
+	getFace(faces[1])._vertices[1] = v[1];
+	getFace(faces[1])._vertices[2] = e2;
+	getVertex(v[0])._faces.insert(faces[1]);
+	getFace(faces[1]).sortVertices();
+
+	return true;
+}
+
+size_t Mesh::flipEdges()
+{
+	//every flip lowers the total valence deviation, so the queue runs dry
+	std::queue<std::array<GLuint, 2>> queue;
+	for (auto& p : _pairs)
+		queue.push(p._vertices);
+
+	size_t flips = 0;
+	while (!queue.empty())
+	{
+		std::array<GLuint, 2> e = queue.front();
+		queue.pop();
+
+		//opposite vertices have to be found before the flip
+		std::array<GLuint, 2> v = { {e[0], e[0]} };
+		size_t found = 0;
+		for (auto f : getVertex(e[0])._faces)
+			if (contains(f, e[1]) && found < 2)
+				for (auto id : getFace(f)._vertices)
+					if (id != e[0] && id != e[1])
+						v[found++] = id;
+
+		if (!flip(e[0], e[1]))
+			continue;
+		++flips;
+
+		//edges around the flipped one may now improve too
+		for (auto a : e)
+			for (auto b : v)
+				queue.push({ {a, b} });
+	}
+
+	buildPairs();
+	return flips;
+}
+
+size_t Mesh::adjacencyBytes() const
+{
+	size_t bytes = _vertexFaces.bytes();
+	for (auto& v : _simpleVertices)
+		bytes += sizeof(v._neighbors) + sizeof(v._faces) + v._neighbors.heapBytes() + v._faces.heapBytes();
+	return bytes;
+}
+
+void Mesh::buildPairs()
+{
+	//neighbors are sorted, so pairs (v, n > v) come out sorted and unique
+	_pairs.clear();
+	for (auto& v : _simpleVertices)
+		for (auto n : v._neighbors)
+			if (n > v._id)
+				_pairs.push_back(Pair(v._id, n));
+	for (size_t i = 0; i < _pairs.size(); ++i)
+		_pairs[i]._id = i;
+}
+
+void Mesh::vertexRelocation(GLuint iterations)
+{
+	//topology does not change between iterations, only the position buffers are swapped
+	_streams.gatherPositions(_simpleVertices);
+	_streams.gatherNeighbors(_simpleVertices);
+	_streams.gatherFaces(_simpleVertices, _faces);
+	for (GLuint i = 0; i < iterations; ++i)
+		_streams.relax(true);
+	_streams.scatterPositions(_simpleVertices);
+}
+
+void Mesh::gatherTriangles(std::vector<glm::vec3>& positions, std::vector<std::array<GLuint, 3>>& triangles)
+{
+	positions.resize(_simpleVertices.size());
+	triangles.resize(_faces.size());
+	parallelFor(0, positions.size(), [&](size_t i) { positions[i] = _simpleVertices[i]._position; });
+	parallelFor(0, triangles.size(), [&](size_t f)
+	{
+		for (size_t k = 0; k < 3; ++k)
+			triangles[f][k] = findVertexPosition(_faces[f]._vertices[k]);
+	});
+}
+
+void Mesh::buildReference()
+{
+	std::vector<glm::vec3> positions;
+	std::vector<std::array<GLuint, 3>> triangles;
+	gatherTriangles(positions, triangles);
+	_reference.build(positions, triangles);
+}
+
+void Mesh::projectVertices()
+{
+	_streams.gatherPositions(_simpleVertices);
+	_reference.project(_streams.size(), _streams._x.data(), _streams._y.data(), _streams._z.data());
+	_streams.scatterPositions(_simpleVertices);
+}
+
+void Mesh::computeSizingField(GLdouble length)
+{
+	if (!_remeshTarget._adaptive)
+	{
+		for (auto& v : _simpleVertices)
+			v._size = length;
+		return;
+	}
+
+	_streams.gatherPositions(_simpleVertices);
+	_streams.gatherNeighbors(_simpleVertices);
+	_streams.gatherFaces(_simpleVertices, _faces);
+	_streams.sizingField
+	(
+		_remeshTarget._adaptiveError * length,
+		_remeshTarget._minScale * length,
+		_remeshTarget._maxScale * length,
+		_remeshTarget._sizeSmoothing
+	);
+	_streams.scatterSizes(_simpleVertices);
+}
+
+bool Mesh::isCollapseShort(GLuint newId, GLuint oldId)
+{
+	const SimpleVertex& a = getVertex(newId);
+	const SimpleVertex& b = getVertex(oldId);
+	glm::vec3 position = (a._position + b._position) / 2.f;
+	GLdouble size = std::min(a._size, b._size);
+	for (auto v : { &a, &b })
+		for (auto n : v->_neighbors)
+			if (n != newId && n != oldId && glm::distance(position, getVertex(n)._position) > REMESH_MAX_RATIO * .5 * (size + getVertex(n)._size))
+				return false;
+	return true;
+}
+
+void Mesh::measureEdgeLengths(RemeshIteration& iteration)
+{
+	//lengths are divided by the target length, bin i holds ratios in [i / 15, (i + 1) / 15), the last bin also all longer edges; one histogram per thread
+	const GLdouble width = 1.0 / 15.0;
+	std::vector<std::vector<size_t>> local(parallelThreads(_pairs.size()), std::vector<size_t>(REMESH_HISTOGRAM_BINS, 0));
+	parallelChunks(0, _pairs.size(), [&](size_t chunkBegin, size_t chunkEnd, size_t thread)
+	{
+		for (size_t i = chunkBegin; i < chunkEnd; ++i)
+		{
+			const SimpleVertex& a = getVertex(_pairs[i]._vertices[0]);
+			const SimpleVertex& b = getVertex(_pairs[i]._vertices[1]);
+			GLdouble bin = glm::distance(a._position, b._position) / (targetLength(a, b) * width);
+			++local[thread][bin < REMESH_HISTOGRAM_BINS ? static_cast<size_t>(bin) : REMESH_HISTOGRAM_BINS - 1];
+		}
+	});
+	std::vector<size_t> bins(REMESH_HISTOGRAM_BINS, 0);
+	for (auto& h : local)
+		for (size_t i = 0; i < REMESH_HISTOGRAM_BINS; ++i)
+			bins[i] += h[i];
+
+	size_t edges = std::max<size_t>(1, _pairs.size());
+	iteration._inRange = .0f;
+	for (size_t i = 0; i < REMESH_HISTOGRAM_BINS; ++i)
+	{
+		iteration._histogram[i] = static_cast<GLfloat>(bins[i]) / edges;
+		if (i >= static_cast<size_t>(std::lround(15.0 * REMESH_MIN_RATIO)) && i < static_cast<size_t>(std::lround(15.0 * REMESH_MAX_RATIO)))
+			iteration._inRange += iteration._histogram[i];
+	}
+}
+
+bool Mesh::remeshIteration(std::chrono::steady_clock::time_point deadline, RemeshIteration& iteration)
+{
+	//the clock is read once per this many operations
+	const size_t checkInterval = 64;
+	auto startTime = std::chrono::steady_clock::now();
+	auto elapsed = [&startTime]()
+	{
+		auto now = std::chrono::steady_clock::now();
+		double seconds = std::chrono::duration<double>(now - startTime).count();
+		startTime = now;
+		return seconds;
+	};
+
+	//collapse edges shorter than 4/5 of their target length; a pair is dead once one of its vertices took part in a collapse after it was added, the dead ones are dropped in one go at the end of the pass
+	std::vector<size_t> touched(_simpleVertices.empty() ? 0 : _simpleVertices.back()._id + 1, 0);
+	auto alive = [&](const Pair& p, size_t i) { return touched[p._vertices[0]] <= i && touched[p._vertices[1]] <= i; };
+	auto compact = [&]()
+	{
+		size_t kept = 0;
+		for (size_t i = 0; i < _pairs.size(); ++i)
+			if (alive(_pairs[i], i))
+			{
+				_pairs[kept] = _pairs[i];
+				_pairs[kept]._id = kept;
+				++kept;
+			}
+		_pairs.resize(kept);
+	};
+	for (size_t i = 0; i < _pairs.size(); ++i)
+	{
+		if (i % checkInterval == 0 && std::chrono::steady_clock::now() > deadline)
+		{
+			compact();
+			iteration._collapseTime = elapsed();
+			return false;
+		}
+
+		if
+		(
+			alive(_pairs[i], i) &&
+			calculateLength
+			(
+				getVertex(_pairs[i]._vertices[0])._position[0] -
+				getVertex(_pairs[i]._vertices[1])._position[0],
+				getVertex(_pairs[i]._vertices[0])._position[1] -
+				getVertex(_pairs[i]._vertices[1])._position[1],
+				getVertex(_pairs[i]._vertices[0])._position[2] -
+				getVertex(_pairs[i]._vertices[1])._position[2]
+			) < REMESH_MIN_RATIO * targetLength(getVertex(_pairs[i]._vertices[0]), getVertex(_pairs[i]._vertices[1])) &&
+			isCollapseShort(_pairs[i]._vertices[0], _pairs[i]._vertices[1]) &&
+			isCollapseValid(_pairs[i]._vertices[0], _pairs[i]._vertices[1])
+		)
+		{
+			GLuint newId = _pairs[i]._vertices[0];
+			GLuint oldId = _pairs[i]._vertices[1];
+			collapse(newId, oldId);
+			//	pairs of the kept vertex are appended, so they are visited later in this pass
+			touched[newId] = touched[oldId] = _pairs.size();
+			for (auto n : getVertex(newId)._neighbors)
+				_pairs.push_back(Pair(newId, n));
+			++iteration._collapses;
+		}
+	}
+	compact();
+	iteration._collapseTime = elapsed();
+
+	//split edges longer than 4/3 of their target length
+	for (int i = _pairs.size() - 1; i >= 0; --i)
+	{
+		if (i % checkInterval == 0 && std::chrono::steady_clock::now() > deadline)
+		{
+			iteration._splitTime = elapsed();
+			return false;
+		}
+
+		if
+		(
+			calculateLength
+			(
+				getVertex(_pairs[i]._vertices[0])._position[0] -
+				getVertex(_pairs[i]._vertices[1])._position[0],
+				getVertex(_pairs[i]._vertices[0])._position[1] -
+				getVertex(_pairs[i]._vertices[1])._position[1],
+				getVertex(_pairs[i]._vertices[0])._position[2] -
+				getVertex(_pairs[i]._vertices[1])._position[2]
+			) > REMESH_MAX_RATIO * targetLength(getVertex(_pairs[i]._vertices[0]), getVertex(_pairs[i]._vertices[1]))
+		)
+		{
+			size_t vertices = _simpleVertices.size();
+			split(i);
+			iteration._splits += _simpleVertices.size() - vertices;
+		}
+	}
+	iteration._splitTime = elapsed();
+	if (std::chrono::steady_clock::now() > deadline)
+		return false;
+
+	//flip edges towards regular valence
+	iteration._flips = flipEdges();
+	iteration._flipTime = elapsed();
+	if (std::chrono::steady_clock::now() > deadline)
+		return false;
+
+	//vertex relocation
+	vertexRelocation(_remeshTarget._relaxationIterations);
+	iteration._relocationTime = elapsed();
+
+	//tangential smoothing still drifts off curved parts of the surface
+	if (_remeshTarget._project)
+	{
+		projectVertices();
+		iteration._projectionTime = elapsed();
+	}
+
+	return true;
+}
+
+void Mesh::incrementalRemeshing(const RemeshTarget& target)
+{
+	_remeshTarget = target;
+	_remeshLog.clear();
+	_remeshBest = 0;
+
+	auto deadline = target._timeBudget > 0.0 ?
+		std::chrono::steady_clock::now() + std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(target._timeBudget)) :
+		std::chrono::steady_clock::time_point::max();
+
+	//get target edge length (by default average length of all pairs)
+	_remeshLength = target._edgeLength;
+	if (_remeshLength <= 0.0)
+	{
+		_remeshLength = 0.0;
+		for (auto& p : _pairs)
+			_remeshLength += glm::distance(getVertex(p._vertices[0])._position, getVertex(p._vertices[1])._position);
+		_remeshLength /= std::max<size_t>(1, _pairs.size());
+	}
+	if (_remeshLength <= 0.0)
+		return;
+
+	if (target._project)
+		buildReference();
+
+	//the input mesh is the fallback
+	computeSizingField(_remeshLength);
+	_remeshLog.push_back(RemeshIteration());
+	measureEdgeLengths(_remeshLog.back());
+
+	//copy of the best mesh, taken lazily before it is changed
+	std::vector<SimpleVertex> bestVertices;
+	std::vector<Face> bestFaces;
+	std::vector<Pair> bestPairs;
+	bool bestStored = false;
+
+	for (GLuint i = 0; i < target._iterations; ++i)
+	{
+		if (_remeshLog.size() - 1 == _remeshBest)
+		{
+			bestVertices = _simpleVertices;
+			bestFaces = _faces;
+			bestPairs = _pairs;
+			bestStored = true;
+		}
+
+		RemeshIteration iteration;
+		iteration._complete = remeshIteration(deadline, iteration);
+		computeSizingField(_remeshLength);
+		measureEdgeLengths(iteration);
+		_remeshLog.push_back(iteration);
+		preview();
+
+		//an interrupted iteration may leave flips and relocation undone, it is never kept; the input is kept only if no iteration completes
+		if (iteration._complete && (_remeshBest == 0 || iteration._inRange >= _remeshLog[_remeshBest]._inRange))
+		{
+			_remeshBest = _remeshLog.size() - 1;
+			bestStored = false;
+		}
+
+		//out of time, or the distribution of lengths does not change any more
+		if (!iteration._complete)
+			break;
+		if (target._tolerance >= 0.f && iteration.histogramDistance(_remeshLog[_remeshLog.size() - 2]) < target._tolerance)
+			break;
+	}
+
+	//the current mesh is worse than an earlier one
+	if (bestStored && _remeshBest != _remeshLog.size() - 1)
+	{
+		_simpleVertices = std::move(bestVertices);
+		_faces = std::move(bestFaces);
+		_pairs = std::move(bestPairs);
+	}
 }
\ No newline at end of file
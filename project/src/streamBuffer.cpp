@@ -0,0 +1,68 @@
+#include "../include/streamBuffer.h"
+
+void StreamBuffer::wait(GLuint region)
+{
+	GLsync& fence = _fences[region];
+	if (!fence)
+		return;
+
+	//the first wait flushes commands, so the fence is guaranteed to signal
+	GLbitfield flags = GL_SYNC_FLUSH_COMMANDS_BIT;
+	while (true)
+	{
+		GLenum result = glClientWaitSync(fence, flags, STREAM_BUFFER_WAIT);
+		if (result == GL_ALREADY_SIGNALED || result == GL_CONDITION_SATISFIED || result == GL_WAIT_FAILED)
+			break;
+		flags = 0;
+	}
+	glDeleteSync(fence);
+	fence = 0;
+}
+
+void StreamBuffer::allocate(size_t regionSize)
+{
+	release();
+
+	const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+	_regionSize = regionSize;
+	glCreateBuffers(1, &_buffer);
+	glNamedBufferStorage(_buffer, bytes(), nullptr, flags);
+	_mapped = static_cast<uint8_t*>(glMapNamedBufferRange(_buffer, 0, bytes(), flags));
+	_region = STREAM_BUFFER_REGIONS - 1;
+}
+
+void* StreamBuffer::map(size_t bytes)
+{
+	//regions are kept 256-byte aligned for any offset binding; growth is geometric, so a growing preview reallocates rarely
+	if (bytes > _regionSize || !_mapped)
+		allocate(std::max((std::max(bytes, 2 * _regionSize) + 255) & ~static_cast<size_t>(255), static_cast<size_t>(256)));
+
+	_region = (_region + 1) % STREAM_BUFFER_REGIONS;
+	wait(_region);
+	return _mapped + offset();
+}
+
+void StreamBuffer::fence()
+{
+	if (!_buffer)
+		return;
+
+	if (_fences[_region])
+		glDeleteSync(_fences[_region]);
+	_fences[_region] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+}
+
+void StreamBuffer::release()
+{
+	if (!_buffer)
+		return;
+
+	//the GPU may still read the storage
+	for (GLuint r = 0; r < STREAM_BUFFER_REGIONS; ++r)
+		wait(r);
+	glUnmapNamedBuffer(_buffer);
+	glDeleteBuffers(1, &_buffer);
+	_buffer = 0;
+	_mapped = nullptr;
+	_regionSize = 0;
+}
\ No newline at end of file
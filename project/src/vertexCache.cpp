@@ -0,0 +1,162 @@
+#include "../include/vertexCache.h"
+
+VertexCacheStats simulateVertexCache(const std::vector<GLuint>& indices, size_t vertexCount, size_t cacheSize)
+{
+	VertexCacheStats stats;
+	if (indices.size() < 3)
+		return stats;
+
+	//a vertex is in the cache if it was pushed less than cacheSize misses ago
+	std::vector<size_t> pushed(vertexCount, 0);
+	std::vector<bool> referenced(vertexCount, false);
+	size_t misses = 0;
+	size_t vertices = 0;
+	for (auto i : indices)
+	{
+		if (!referenced[i])
+		{
+			referenced[i] = true;
+			++vertices;
+		}
+		if (pushed[i] == 0 || misses - pushed[i] + 1 > cacheSize)
+			pushed[i] = ++misses;
+	}
+
+	stats._acmr = static_cast<GLfloat>(misses) / (indices.size() / 3);
+	stats._atvr = static_cast<GLfloat>(misses) / vertices;
+	return stats;
+}
+
+/**
+ * score of vertex (Forsyth's constants)
+ * @param cachePosition position in the LRU cache (-1 - not cached)
+ * @param remaining number of not yet emitted triangles using the vertex
+ * @return score
+ */
+static inline GLfloat vertexScore(int cachePosition, GLuint remaining)
+{
+	if (remaining == 0)
+		return -1.f;
+
+	GLfloat score = .0f;
+	if (cachePosition >= 0)
+	{
+		//the last triangle's vertices get a fixed score, so the next triangle does not simply reuse two of them
+		if (cachePosition < 3)
+			score = .75f;
+		else
+			score = std::pow(1.f - (cachePosition - 3) / static_cast<GLfloat>(VERTEX_CACHE_SIZE - 3), 1.5f);
+	}
+
+	//vertices with few triangles left are finished first, so they do not linger as lone triangles
+	return score + 2.f / std::sqrt(static_cast<GLfloat>(remaining));
+}
+
+void optimizeVertexCache(std::vector<GLuint>& indices, size_t vertexCount)
+{
+	size_t triangleCount = indices.size() / 3;
+	if (triangleCount < 2)
+		return;
+
+	//triangles of every vertex (CSR), the first remaining[v] entries are the live ones
+	std::vector<GLuint> offsets(vertexCount + 1, 0);
+	for (auto i : indices)
+		++offsets[i + 1];
+	for (size_t v = 0; v < vertexCount; ++v)
+		offsets[v + 1] += offsets[v];
+	std::vector<GLuint> triangles(offsets[vertexCount]);
+	std::vector<GLuint> remaining(vertexCount, 0);
+	for (size_t t = 0; t < triangleCount; ++t)
+		for (size_t k = 0; k < 3; ++k)
+		{
+			GLuint v = indices[3 * t + k];
+			triangles[offsets[v] + remaining[v]++] = static_cast<GLuint>(t);
+		}
+
+	std::vector<GLfloat> score(vertexCount);
+	for (size_t v = 0; v < vertexCount; ++v)
+		score[v] = vertexScore(-1, remaining[v]);
+
+	std::vector<bool> emitted(triangleCount, false);
+	std::vector<GLuint> result;
+	result.reserve(indices.size());
+	std::vector<GLuint> cache;
+	std::vector<GLuint> nextCache;
+	cache.reserve(VERTEX_CACHE_SIZE + 3);
+	nextCache.reserve(VERTEX_CACHE_SIZE + 3);
+
+	size_t best = 0;
+	size_t cursor = 0;
+	for (size_t emittedCount = 0; emittedCount < triangleCount; ++emittedCount)
+	{
+		//nothing in the cache has triangles left, continue with the next triangle in input order
+		if (best == triangleCount)
+		{
+			while (emitted[cursor])
+				++cursor;
+			best = cursor;
+		}
+
+		emitted[best] = true;
+		const GLuint* corners = indices.data() + 3 * best;
+		for (size_t k = 0; k < 3; ++k)
+		{
+			GLuint v = corners[k];
+			result.push_back(v);
+
+			//remove the triangle from live triangles of the vertex
+			GLuint* begin = triangles.data() + offsets[v];
+			GLuint* end = begin + remaining[v];
+			*std::find(begin, end, static_cast<GLuint>(best)) = *(end - 1);
+			--remaining[v];
+		}
+
+		//LRU: vertices of the emitted triangle go to the front
+		nextCache.assign(corners, corners + 3);
+		for (auto v : cache)
+			if (v != corners[0] && v != corners[1] && v != corners[2])
+				nextCache.push_back(v);
+		for (size_t i = VERTEX_CACHE_SIZE; i < nextCache.size(); ++i)
+			score[nextCache[i]] = vertexScore(-1, remaining[nextCache[i]]);
+		nextCache.resize(std::min(nextCache.size(), VERTEX_CACHE_SIZE));
+		cache.swap(nextCache);
+
+		//only vertices in the cache changed their scores, so the best triangle is one of theirs
+		for (size_t i = 0; i < cache.size(); ++i)
+			score[cache[i]] = vertexScore(static_cast<int>(i), remaining[cache[i]]);
+		best = triangleCount;
+		GLfloat bestScore = -1.f;
+		for (auto v : cache)
+			for (GLuint j = offsets[v]; j < offsets[v] + remaining[v]; ++j)
+			{
+				GLuint t = triangles[j];
+				const GLuint* c = indices.data() + 3 * t;
+				GLfloat triangleScore = score[c[0]] + score[c[1]] + score[c[2]];
+				if (triangleScore > bestScore)
+				{
+					bestScore = triangleScore;
+					best = t;
+				}
+			}
+	}
+
+	indices.swap(result);
+}
+
+std::vector<GLuint> optimizeVertexFetch(std::vector<GLuint>& indices, size_t vertexCount)
+{
+	const GLuint unused = std::numeric_limits<GLuint>::max();
+	std::vector<GLuint> remap(vertexCount, unused);
+	GLuint next = 0;
+	for (auto& i : indices)
+	{
+		if (remap[i] == unused)
+			remap[i] = next++;
+		i = remap[i];
+	}
+
+	for (auto& r : remap)
+		if (r == unused)
+			r = next++;
+	return remap;
+}
\ No newline at end of file
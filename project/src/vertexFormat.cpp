@@ -0,0 +1,200 @@
+#include "../include/vertexFormat.h"
+
+/**
+ * encodes a unit vector into 2 octahedral components in [-1, 1] (the sphere is projected on the octahedron, the lower half is folded over the upper one)
+ * @param n unit vector
+ * @return octahedral components
+ */
+static inline glm::vec2 octahedralEncode(const glm::vec3& n)
+{
+	GLfloat sum = std::abs(n.x) + std::abs(n.y) + std::abs(n.z);
+	if (sum <= .0f)
+		return glm::vec2(.0f);
+
+	glm::vec2 e = glm::vec2(n.x, n.y) / sum;
+	if (n.z < .0f)
+		e = glm::vec2((1.f - std::abs(e.y)) * (e.x >= .0f ? 1.f : -1.f), (1.f - std::abs(e.x)) * (e.y >= .0f ? 1.f : -1.f));
+	return e;
+}
+
+/**
+ * decodes octahedral components, same as octahedralDecode in vertexCore.glsl
+ * @param e octahedral components
+ * @return unit vector
+ */
+static inline glm::vec3 octahedralDecode(const glm::vec2& e)
+{
+	glm::vec3 n(e.x, e.y, 1.f - std::abs(e.x) - std::abs(e.y));
+	GLfloat t = std::max(-n.z, .0f);
+	n.x += n.x >= .0f ? -t : t;
+	n.y += n.y >= .0f ? -t : t;
+	return glm::normalize(n);
+}
+
+/**
+ * signed normalized 16-bit integer
+ * @param v value in [-1, 1]
+ * @return quantized value
+ */
+static inline int16_t snorm16(GLfloat v)
+{
+	return static_cast<int16_t>(std::round(glm::clamp(v, -1.f, 1.f) * 32767.f));
+}
+
+/**
+ * packs a color into 4 unsigned normalized bytes (alpha is 1)
+ * @param c color
+ * @return packed value
+ */
+static inline uint32_t packUnorm8(const glm::vec3& c)
+{
+	auto component = [](GLfloat v) { return static_cast<uint32_t>(std::round(glm::clamp(v, .0f, 1.f) * 255.f)); };
+	return component(c.x) | (component(c.y) << 8) | (component(c.z) << 16) | (255u << 24);
+}
+
+/**
+ * copies a value into packed data
+ * @param data packed data
+ * @param offset offset in bytes
+ * @param value value to copy
+ */
+template <typename T>
+static inline void store(std::vector<uint8_t>& data, size_t offset, const T& value)
+{
+	std::memcpy(data.data() + offset, &value, sizeof(T));
+}
+
+PackedVertices PackedVertices::positions(const std::vector<SimpleVertex>& vertices)
+{
+	PackedVertices packed;
+	packed._stride = sizeof(glm::vec3);
+	packed._attributes = { { 0, 3, GL_FLOAT, GL_FALSE, 0 } };
+	packed._data.resize(vertices.size() * packed._stride);
+	for (size_t i = 0; i < vertices.size(); ++i)
+		store(packed._data, i * packed._stride, vertices[i]._position);
+	return packed;
+}
+
+PackedVertices PackedVertices::positions(const std::vector<Vertex>& vertices)
+{
+	PackedVertices packed;
+	packed._stride = sizeof(glm::vec3);
+	packed._attributes = { { 0, 3, GL_FLOAT, GL_FALSE, 0 } };
+	packed._data.resize(vertices.size() * packed._stride);
+	for (size_t i = 0; i < vertices.size(); ++i)
+		store(packed._data, i * packed._stride, vertices[i]._position);
+	return packed;
+}
+
+PackedVertices PackedVertices::attributes(const std::vector<Vertex>& vertices, bool quantize)
+{
+	PackedVertices packed;
+	if (quantize)
+	{
+		//position 6 (+2 padding), color 4, texcoord 4, normal 4 bytes
+		packed._stride = 20;
+		packed._attributes =
+		{
+			{ 0, 3, GL_UNSIGNED_SHORT, GL_TRUE, 0 },
+			{ 1, 4, GL_UNSIGNED_BYTE, GL_TRUE, 8 },
+			{ 2, 2, GL_HALF_FLOAT, GL_FALSE, 12 },
+			{ 3, 2, GL_SHORT, GL_TRUE, 16 }
+		};
+
+		//positions are normalized to the bounding box, flat boxes keep scale 1 in their flat dimension
+		glm::vec3 minimum(std::numeric_limits<GLfloat>::max());
+		glm::vec3 maximum(-std::numeric_limits<GLfloat>::max());
+		for (auto& v : vertices)
+		{
+			minimum = glm::min(minimum, v._position);
+			maximum = glm::max(maximum, v._position);
+		}
+		if (vertices.empty())
+			minimum = maximum = glm::vec3(.0f);
+		glm::vec3 size = maximum - minimum;
+		for (int k = 0; k < 3; ++k)
+			if (size[k] <= .0f)
+				size[k] = 1.f;
+		packed._dequantization = { minimum, size, true };
+
+		packed._data.resize(vertices.size() * packed._stride);
+		QuantizationError& error = packed._error;
+		for (size_t i = 0; i < vertices.size(); ++i)
+		{
+			const Vertex& v = vertices[i];
+			size_t offset = i * packed._stride;
+
+			glm::vec3 unit = glm::clamp((v._position - minimum) / size, .0f, 1.f);
+			std::array<uint16_t, 3> position;
+			for (int k = 0; k < 3; ++k)
+				position[k] = static_cast<uint16_t>(std::round(unit[k] * 65535.f));
+			uint32_t color = packUnorm8(v._color);
+			uint32_t texcoord = glm::packHalf2x16(v._texcoord);
+			glm::vec3 normal = glm::length(v._normal) > .0f ? glm::normalize(v._normal) : glm::vec3(.0f);
+			glm::vec2 octahedral = octahedralEncode(normal);
+			std::array<int16_t, 2> packedNormal = { { snorm16(octahedral.x), snorm16(octahedral.y) } };
+
+			store(packed._data, offset, position);
+			store(packed._data, offset + 8, color);
+			store(packed._data, offset + 12, texcoord);
+			store(packed._data, offset + 16, packedNormal);
+
+			//decode as the GPU does and compare
+			glm::vec3 decodedPosition = minimum + size * glm::vec3(position[0], position[1], position[2]) / 65535.f;
+			error._position = std::max(error._position, glm::distance(decodedPosition, v._position));
+			glm::vec2 decodedTexcoord = glm::unpackHalf2x16(texcoord);
+			error._texcoord = std::max(error._texcoord, std::max(std::abs(decodedTexcoord.x - v._texcoord.x), std::abs(decodedTexcoord.y - v._texcoord.y)));
+			for (int k = 0; k < 3; ++k)
+				error._color = std::max(error._color, std::abs(((color >> (8 * k)) & 0xff) / 255.f - v._color[k]));
+			if (normal != glm::vec3(.0f))
+			{
+				glm::vec3 decodedNormal = octahedralDecode(glm::max(glm::vec2(packedNormal[0], packedNormal[1]) / 32767.f, -1.f));
+				error._normal = std::max(error._normal, glm::degrees(std::acos(glm::clamp(glm::dot(decodedNormal, normal), -1.f, 1.f))));
+			}
+		}
+		GLfloat diagonal = glm::length(maximum - minimum);
+		error._positionRelative = diagonal > .0f ? error._position / diagonal : .0f;
+		return packed;
+	}
+
+	//Vertex holds exactly the shader inputs, so it is copied as it is
+	packed._stride = sizeof(Vertex);
+	packed._attributes =
+	{
+		{ 0, 3, GL_FLOAT, GL_FALSE, offsetof(Vertex, _position) },
+		{ 1, 3, GL_FLOAT, GL_FALSE, offsetof(Vertex, _color) },
+		{ 2, 2, GL_FLOAT, GL_FALSE, offsetof(Vertex, _texcoord) },
+		{ 3, 3, GL_FLOAT, GL_FALSE, offsetof(Vertex, _normal) }
+	};
+	packed._data.resize(vertices.size() * packed._stride);
+	if (!vertices.empty())
+		std::memcpy(packed._data.data(), vertices.data(), packed._data.size());
+	return packed;
+}
+
+void PackedVertices::reorder(const std::vector<GLuint>& remap)
+{
+	std::vector<uint8_t> data(_data.size());
+	for (size_t i = 0; i < remap.size(); ++i)
+		std::memcpy(data.data() + remap[i] * _stride, _data.data() + i * _stride, _stride);
+	_data.swap(data);
+}
+
+void PackedVertices::setAttributePointers() const
+{
+	for (auto& a : _attributes)
+	{
+		glVertexAttribPointer(a._location, a._size, a._type, a._normalized, _stride, (GLvoid*)a._offset);
+		glEnableVertexAttribArray(a._location);
+	}
+}
+
+void PackedVertices::setAttributeFormats(GLuint vao, GLuint binding) const
+{
+	for (auto& a : _attributes)
+	{
+		glVertexArrayAttribFormat(vao, a._location, a._size, a._type, a._normalized, static_cast<GLuint>(a._offset));
+		glVertexArrayAttribBinding(vao, a._location, binding);
+		glEnableVertexArrayAttrib(vao, a._location);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,255 @@
+#include "../include/vertexStreams.h"
+
+/**
+ * copies upper triangle of symmetric quadric to coefficient arrays
+ * @param q quadric matrix (column-major, but symmetric)
+ * @param quad coefficient arrays
+ * @param slot slot to write
+ */
+static inline void storeQuadric(const glm::mat4& q, std::array<std::vector<GLfloat>, 10>& quad, size_t slot)
+{
+	size_t k = 0;
+	for (size_t r = 0; r < 4; ++r)
+		for (size_t c = r; c < 4; ++c)
+			quad[k++][slot] = q[c][r];
+}
+
+void VertexStreams::gatherPositions(const std::vector<SimpleVertex>& vertices)
+{
+	size_t n = vertices.size();
+	_ids.resize(n);
+	_x.resize(n);
+	_y.resize(n);
+	_z.resize(n);
+	_sizes.resize(n);
+	parallelFor(0, n, [&](size_t i)
+	{
+		_ids[i] = vertices[i]._id;
+		_x[i] = vertices[i]._position.x;
+		_y[i] = vertices[i]._position.y;
+		_z[i] = vertices[i]._position.z;
+		_sizes[i] = vertices[i]._size;
+	});
+}
+
+void VertexStreams::gatherNeighbors(const std::vector<SimpleVertex>& vertices)
+{
+	size_t n = vertices.size();
+	_neighbors._offsets.resize(n + 1);
+	_neighbors._offsets[0] = 0;
+	for (size_t i = 0; i < n; ++i)
+		_neighbors._offsets[i + 1] = _neighbors._offsets[i] + vertices[i]._neighbors.size();
+
+	_neighbors._indices.resize(_neighbors._offsets[n]);
+	parallelFor(0, n, [&](size_t i)
+	{
+		GLuint* out = _neighbors._indices.data() + _neighbors._offsets[i];
+		for (auto id : vertices[i]._neighbors)
+			*out++ = slot(id);
+	});
+}
+
+void VertexStreams::gatherFaces(const std::vector<SimpleVertex>& vertices, const std::vector<Face>& faces)
+{
+	_triangles.resize(faces.size());
+	parallelFor(0, faces.size(), [&](size_t f)
+	{
+		for (size_t k = 0; k < 3; ++k)
+			_triangles[f][k] = slot(faces[f]._vertices[k]);
+	});
+
+	//face IDs -> positions, faces are sorted by ID
+	size_t n = vertices.size();
+	_vertexFaces._offsets.resize(n + 1);
+	_vertexFaces._offsets[0] = 0;
+	for (size_t i = 0; i < n; ++i)
+		_vertexFaces._offsets[i + 1] = _vertexFaces._offsets[i] + vertices[i]._faces.size();
+
+	_vertexFaces._indices.resize(_vertexFaces._offsets[n]);
+	parallelFor(0, n, [&](size_t i)
+	{
+		GLuint* out = _vertexFaces._indices.data() + _vertexFaces._offsets[i];
+		for (auto id : vertices[i]._faces)
+			*out++ = std::lower_bound(faces.begin(), faces.end(), id, [](const Face& f, GLuint id) { return f._id < id; }) - faces.begin();
+	});
+}
+
+void VertexStreams::clear()
+{
+	_ids.clear();
+	_x.clear();
+	_y.clear();
+	_z.clear();
+	_sizes.clear();
+	for (auto& q : _quad)
+		q.clear();
+	_attributeQuad.clear();
+	for (auto& e : _edges)
+		e.clear();
+}
+
+GLuint VertexStreams::push(const SimpleVertex& vertex, bool attributes)
+{
+	GLuint slot = _ids.size();
+	_ids.push_back(vertex._id);
+	_x.push_back(vertex._position.x);
+	_y.push_back(vertex._position.y);
+	_z.push_back(vertex._position.z);
+	_sizes.push_back(vertex._size);
+	for (auto& q : _quad)
+		q.push_back(.0f);
+	storeQuadric(vertex._quad, _quad, slot);
+	if (attributes)
+		_attributeQuad.push_back(vertex._attributeQuad);
+	return slot;
+}
+
+void VertexStreams::scatterPositions(std::vector<SimpleVertex>& vertices) const
+{
+	parallelFor(0, vertices.size(), [&](size_t i) { vertices[i]._position = glm::vec3(_x[i], _y[i], _z[i]); });
+}
+
+void VertexStreams::scatterSizes(std::vector<SimpleVertex>& vertices) const
+{
+	parallelFor(0, vertices.size(), [&](size_t i) { vertices[i]._size = _sizes[i]; });
+}
+
+void VertexStreams::computeFaceNormals()
+{
+	_faceNormals.resize(_triangles.size());
+	parallelFor(0, _triangles.size(), [&](size_t f)
+	{
+		const std::array<GLuint, 3>& t = _triangles[f];
+		glm::vec3 p0(_x[t[0]], _y[t[0]], _z[t[0]]);
+		glm::vec3 p1(_x[t[1]], _y[t[1]], _z[t[1]]);
+		glm::vec3 p2(_x[t[2]], _y[t[2]], _z[t[2]]);
+		_faceNormals[f] = glm::cross(p1 - p0, p2 - p0);
+	});
+}
+
+void VertexStreams::sizingField(GLfloat error, GLfloat minSize, GLfloat maxSize, GLuint smoothing)
+{
+	size_t n = size();
+	computeFaceNormals();
+
+	const GLuint* offsets = _neighbors._offsets.data();
+	const GLuint* neighbors = _neighbors._indices.data();
+	_sizes.resize(n);
+	parallelFor(0, n, [&](size_t i)
+	{
+		glm::vec3 normal = vertexNormal(i);
+		if (glm::length(normal) == .0f)
+		{
+			_sizes[i] = maxSize;
+			return;
+		}
+		normal = glm::normalize(normal);
+
+		//normal curvature towards a neighbor is the curvature of the circle touching the tangent plane and passing through it
+		glm::vec3 position(_x[i], _y[i], _z[i]);
+		GLfloat curvature = .0f;
+		for (GLuint j = offsets[i]; j < offsets[i + 1]; ++j)
+		{
+			glm::vec3 edge = glm::vec3(_x[neighbors[j]], _y[neighbors[j]], _z[neighbors[j]]) - position;
+			GLfloat length2 = glm::dot(edge, edge);
+			if (length2 > .0f)
+				curvature = std::max(curvature, 2.f * std::abs(glm::dot(normal, edge)) / length2);
+		}
+
+		//chord of a circle with radius r deviating by error: L = sqrt(6 * error * r - 3 * error^2)
+		GLfloat size2 = curvature > .0f ? 6.f * error / curvature - 3.f * error * error : maxSize * maxSize;
+		_sizes[i] = glm::clamp(size2 > .0f ? std::sqrt(size2) : minSize, minSize, maxSize);
+	});
+
+	//single-edge curvature estimates are noisy, neighbors are averaged with the vertex (Jacobi iterations)
+	std::vector<GLfloat> smoothed(n);
+	for (GLuint s = 0; s < smoothing; ++s)
+	{
+		parallelFor(0, n, [&](size_t i)
+		{
+			GLfloat sum = _sizes[i];
+			for (GLuint j = offsets[i]; j < offsets[i + 1]; ++j)
+				sum += _sizes[neighbors[j]];
+			smoothed[i] = sum / (offsets[i + 1] - offsets[i] + 1);
+		});
+		_sizes.swap(smoothed);
+	}
+}
+
+void VertexStreams::relax(bool tangential)
+{
+	size_t n = size();
+	_relaxedX.resize(n);
+	_relaxedY.resize(n);
+	_relaxedZ.resize(n);
+
+	if (tangential)
+		computeFaceNormals();
+
+	const GLuint* offsets = _neighbors._offsets.data();
+	const GLuint* neighbors = _neighbors._indices.data();
+	parallelFor(0, n, [&](size_t i)
+	{
+		GLuint count = offsets[i + 1] - offsets[i];
+
+		//isolated vertices stay in place, so do boundary vertices of tangential relaxation (more neighbors than faces)
+		if (count == 0 || (tangential && count != _vertexFaces.size(i)))
+		{
+			_relaxedX[i] = _x[i];
+			_relaxedY[i] = _y[i];
+			_relaxedZ[i] = _z[i];
+			return;
+		}
+
+		glm::vec3 centroid(.0f);
+		for (GLuint j = offsets[i]; j < offsets[i + 1]; ++j)
+			centroid += glm::vec3(_x[neighbors[j]], _y[neighbors[j]], _z[neighbors[j]]);
+		centroid /= static_cast<GLfloat>(count);
+
+		glm::vec3 position(_x[i], _y[i], _z[i]);
+		glm::vec3 move = centroid - position;
+
+		//remove the normal component, the vertex slides over the surface instead of shrinking it
+		if (tangential)
+		{
+			glm::vec3 normal = vertexNormal(i);
+			if (glm::length(normal) > .0f)
+			{
+				normal = glm::normalize(normal);
+				move -= normal * glm::dot(normal, move);
+			}
+		}
+
+		_relaxedX[i] = position.x + move.x;
+		_relaxedY[i] = position.y + move.y;
+		_relaxedZ[i] = position.z + move.z;
+	});
+
+	_x.swap(_relaxedX);
+	_y.swap(_relaxedY);
+	_z.swap(_relaxedZ);
+}
+
+void VertexStreams::edgeCosts(GLfloat attributeScale, std::vector<GLfloat>& costs) const
+{
+	size_t m = _edges[0].size();
+	costs.resize(m);
+
+	EdgeCostInput input = { _x.data(), _y.data(), _z.data(), {}, _edges[0].data(), _edges[1].data() };
+	for (size_t k = 0; k < 10; ++k)
+		input._quad[k] = _quad[k].data();
+	//one kernel call per thread on a contiguous range of edges
+	bool attributes = attributeScale > .0f && !_attributeQuad.empty();
+	parallelChunks(0, m, [&](size_t chunkBegin, size_t chunkEnd, size_t)
+	{
+		EdgeCostInput chunk = input;
+		chunk._a += chunkBegin;
+		chunk._b += chunkBegin;
+		edgeCostKernel(chunk, chunkEnd - chunkBegin, costs.data() + chunkBegin);
+
+		//attribute error of merged corners
+		if (attributes)
+			for (size_t i = chunkBegin; i < chunkEnd; ++i)
+				costs[i] += attributeScale * (_attributeQuad[input._a[i]] + _attributeQuad[input._b[i]]).error();
+	});
+}
\ No newline at end of file